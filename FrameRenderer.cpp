@@ -0,0 +1,106 @@
+#include "FrameRenderer.hpp"
+
+FrameRenderer::FrameRenderer(const FrameRendererArgs& args, AsyncVideoWriter* video_writer)
+    : args(args), video_writer(video_writer)
+{
+    last_shown = std::chrono::steady_clock::now();
+    render_thread = std::thread(&FrameRenderer::renderLoop, this);
+}
+
+FrameRenderer::~FrameRenderer()
+{
+    finish();
+}
+
+void FrameRenderer::submit(RenderJob job)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        slot_free.wait(lock, [this] { return queue.size() < args.queue_size || finishing; });
+        if (finishing)
+            return;
+        queue.push_back(std::move(job));
+    }
+    job_ready.notify_one();
+}
+
+void FrameRenderer::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishing = true;
+    }
+    job_ready.notify_all();
+    slot_free.notify_all();
+    if (render_thread.joinable())
+        render_thread.join();
+}
+
+bool FrameRenderer::quitRequested() const
+{
+    return quit_requested;
+}
+
+void FrameRenderer::renderLoop()
+{
+    while (true)
+    {
+        RenderJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_ready.wait(lock, [this] { return !queue.empty() || finishing; });
+            if (queue.empty())
+                break;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        slot_free.notify_one();
+
+        draw(job);
+        if (video_writer)
+            video_writer->write(job.frame); // shared with the encoder, only read from now on
+
+        if (args.show_window && !job.annotations_only && !quit_requested)
+        {
+            cv::imshow("Frame", job.frame);
+            window_shown = true;
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - last_shown;
+            int to_wait = args.frame_time_ms - elapsed.count();
+            to_wait = to_wait > 0 ? to_wait : 1;
+            if (cv::waitKey(to_wait) == 'q')
+                quit_requested = true;
+            last_shown = std::chrono::steady_clock::now();
+        }
+    }
+    if (window_shown)
+        cv::destroyWindow("Frame");
+}
+
+void FrameRenderer::draw(RenderJob& job)
+{
+    cv::Mat& frame_vis = job.frame;
+    cv::rectangle(frame_vis, job.ground_truth, cv::Scalar(0, 255, 255), 2, 1);
+    if (job.annotations_only)
+        return;
+
+    for (int i = 0; i < job.trackers.size(); i++)
+    {
+        const TrackerOverlay& overlay = job.trackers[i];
+        for (const auto& box : overlay.debug_boxes)
+            cv::rectangle(frame_vis, box, cv::Scalar(255, 0, 0), 1, 1);
+        if (overlay.bbox.area() > 0)
+        {
+            cv::putText(frame_vis, overlay.name, cv::Point(overlay.bbox.x + overlay.bbox.width + 5, overlay.bbox.y + 17 * i), cv::FONT_HERSHEY_SIMPLEX, 0.5, overlay.color,
+                2);
+            cv::rectangle(frame_vis, overlay.bbox, overlay.color, 2, 1);
+        }
+
+        cv::Scalar state_color = overlay.valid ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 0, 255);
+        cv::putText(frame_vis,
+            overlay.info,
+            cv::Point(10, (frame_vis.rows - 20) - 30 * i), cv::FONT_HERSHEY_SIMPLEX, 0.5, state_color, 2);
+    }
+    cv::putText(frame_vis,
+        "OCCLUSION: " + std::to_string(job.occluded),
+        cv::Point(10, (frame_vis.rows - 20) - 30 * job.trackers.size()), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 255, 0), 2);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "AsyncVideoWriter.hpp"
+
+// Everything needed to draw one tracker on a frame, captured on the tracking thread
+struct TrackerOverlay
+{
+    std::string name;
+    cv::Rect bbox;
+    cv::Scalar color;
+    std::string info;
+    bool valid = false;
+    std::vector<cv::Rect> debug_boxes;
+};
+
+struct RenderJob
+{
+    cv::Mat frame; // owned copy of the source frame
+    cv::Rect ground_truth;
+    int occluded = -1;
+    std::vector<TrackerOverlay> trackers;
+    bool annotations_only = false; // draw just the ground truth, do not display
+};
+
+struct FrameRendererArgs
+{
+    bool show_window = true;
+    unsigned frame_time_ms = 1; // minimal time a frame stays on screen
+    size_t queue_size = 8;
+};
+
+// Draws, displays and records frames on a separate thread, so visualization never blocks tracking.
+// HighGUI is only used from the render thread and only when the window is enabled.
+class FrameRenderer
+{
+public:
+    FrameRenderer(const FrameRendererArgs& args, AsyncVideoWriter* video_writer);
+    ~FrameRenderer();
+
+    // Blocks while the queue is full
+    void submit(RenderJob job);
+    // Renders everything queued and stops the render thread
+    void finish();
+    bool quitRequested() const;
+
+private:
+    void renderLoop();
+    void draw(RenderJob& job);
+
+    FrameRendererArgs args;
+    AsyncVideoWriter* video_writer;
+    std::deque<RenderJob> queue;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+    std::condition_variable slot_free;
+    bool finishing = false;
+    std::atomic<bool> quit_requested{ false };
+    std::chrono::time_point<std::chrono::steady_clock> last_shown;
+    bool window_shown = false;
+    std::thread render_thread;
+};
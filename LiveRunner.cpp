@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <spdlog/spdlog.h>
+#include "LiveRunner.hpp"
+#include "TrackerComparator.hpp"
+#include "ThreadPool.hpp"
+#include "VideoFileReader.hpp"
+#include "ImageSequenceReader.hpp"
+
+LiveArgs readLiveArgs(const YAML::Node& config)
+{
+    LiveArgs args;
+    if (const YAML::Node& live_config = config["live"])
+    {
+        args.tracker = live_config["tracker"].as<std::string>(args.tracker);
+        args.streams = live_config["streams"].as<size_t>(args.streams);
+        args.workers = live_config["workers"].as<size_t>(args.workers);
+        args.queue_depth = live_config["queue_depth"].as<size_t>(args.queue_depth);
+        args.max_frame_age = live_config["max_frame_age_ms"].as<double>(args.max_frame_age * 1000) / 1000;
+        args.default_fps = live_config["default_fps"].as<double>(args.default_fps);
+    }
+    return args;
+}
+
+LiveRunner::LiveRunner(const YAML::Node& config) : config(config), args(readLiveArgs(config))
+{
+}
+
+static std::vector<Annotation> loadAnnotations(const DatasetInfo& dataset_info)
+{
+    if (!dataset_info.annotations.empty())
+        return dataset_info.annotations;
+    if (dataset_info.dataset_type == DatasetType::Custom)
+        return loadCustomAnnotations(dataset_info.ground_truth_paths[0]);
+    if (dataset_info.dataset_type == DatasetType::OTB)
+        return loadOTBAnnotations(dataset_info.ground_truth_paths[0]);
+    return {};
+}
+
+bool LiveRunner::setup(const std::vector<DatasetInfo>& all_sequences)
+{
+    // a sequence with a malformed annotation file is left out, the others are still replayed
+    std::vector<std::pair<DatasetInfo, std::vector<Annotation>>> sequences;
+    for (const auto& dataset_info : all_sequences)
+    {
+        try
+        {
+            sequences.emplace_back(dataset_info, loadAnnotations(dataset_info));
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Skipping {}, loading its annotations failed: {}", dataset_info.name, e.what());
+        }
+    }
+    if (sequences.empty())
+    {
+        spdlog::error("No sequences to replay");
+        return false;
+    }
+    size_t streams_num = args.streams > 0 ? args.streams : sequences.size();
+    streams = std::vector<Stream>(streams_num);
+    for (size_t i = 0; i < streams_num; i++)
+    {
+        Stream& stream = streams[i];
+        stream.dataset_info = sequences[i % sequences.size()].first;
+        stream.ground_truths = sequences[i % sequences.size()].second;
+        stream.name = stream.dataset_info.name;
+        if (i >= sequences.size())
+            stream.name += "_" + std::to_string(i / sequences.size());
+
+        try
+        {
+            stream.tracker = createTracker(args.tracker, config);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Creating {} for {} failed: {}", args.tracker, stream.name, e.what());
+        }
+        if (!stream.tracker)
+            return false;
+    }
+
+    workers_num = args.workers > 0 ? args.workers : std::max(1u, std::thread::hardware_concurrency());
+    auto max_age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(args.max_frame_age));
+    scheduler = std::make_unique<FrameScheduler<LiveFrame>>(streams_num, args.queue_depth, max_age);
+    spdlog::info("Live mode: {} streams tracked by {} on {} workers", streams_num, args.tracker, workers_num);
+    return true;
+}
+
+std::unique_ptr<VideoReader> LiveRunner::createReader(const DatasetInfo& dataset_info)
+{
+    if (dataset_info.dataset_type == DatasetType::OTB)
+    {
+        if (!dataset_info.frame_files.empty())
+            return std::make_unique<ImageSequenceReader>(dataset_info.frame_files);
+        return std::make_unique<ImageSequenceReader>(dataset_info.media_path);
+    }
+    return std::make_unique<VideoFileReader>(dataset_info.media_path);
+}
+
+// Stands in for a camera, frames are handed over at the native fps of the source whether someone takes them or not
+void LiveRunner::captureLoop(size_t index)
+{
+    Stream& stream = streams[index];
+    std::unique_ptr<VideoReader> reader = createReader(stream.dataset_info);
+    double fps = reader->getFps() > 0 ? reader->getFps() : args.default_fps;
+    stream.stats.source_fps = fps;
+
+    auto start = std::chrono::steady_clock::now();
+    stream.first_capture = start;
+    for (size_t i = 0;; i++)
+    {
+        LiveFrame frame;
+        if (!reader->getNextFrame(frame.image))
+            break;
+        frame.index = i;
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(i / fps)));
+        scheduler->push(index, std::move(frame));
+    }
+    scheduler->finishStream(index);
+}
+
+void LiveRunner::processFrame(Stream& stream, const FrameScheduler<LiveFrame>::Job& job)
+{
+    const cv::Mat& image = job.frame.image;
+    TrackerState state = stream.tracker->getState();
+    if (!stream.initialized || state == TrackerState::Lost || state == TrackerState::ToBeReinited)
+    {
+        // the first frames may have been dropped, the tracker starts on the annotation of the first one it gets,
+        // a lost one is reinitialized from the annotation as in the evaluation. Without one there is nothing to track
+        if (job.frame.index >= stream.ground_truths.size() || stream.ground_truths[job.frame.index].occluded == 1)
+        {
+            stream.stats.idle++;
+            return;
+        }
+        cv::Rect2f roi = stream.ground_truths[job.frame.index].rect;
+        if (stream.dataset_info.dataset_type == DatasetType::Custom)
+            roi = cv::Rect2f(roi.x * image.cols, roi.y * image.rows, roi.width * image.cols, roi.height * image.rows);
+        stream.tracker->init(image, roi);
+        if (stream.initialized)
+            stream.stats.reinits++;
+        stream.initialized = true;
+    }
+    else
+    {
+        cv::Rect bbox;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        stream.tracker->update(image, bbox);
+        std::chrono::duration<double> processing_time = std::chrono::high_resolution_clock::now() - start_time;
+        stream.stats.processing.record(processing_time.count());
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> latency = now - job.arrival;
+    stream.stats.latency.record(latency.count());
+    stream.stats.processed++;
+    stream.last_result = now;
+}
+
+void LiveRunner::workerLoop()
+{
+    // the scheduler hands out one frame per stream at a time, so a stream is only touched by one worker at once
+    FrameScheduler<LiveFrame>::Job job;
+    while (scheduler->acquire(job))
+    {
+        try
+        {
+            processFrame(streams[job.stream], job);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Tracking {} failed: {}", streams[job.stream].name, e.what());
+        }
+        job.frame.image.release();
+        scheduler->release(job.stream);
+    }
+}
+
+void LiveRunner::run()
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> cameras;
+    {
+        ThreadPool pool(workers_num);
+        std::vector<std::future<void>> workers;
+        for (size_t i = 0; i < workers_num; i++)
+            workers.push_back(pool.submit([this] { workerLoop(); }));
+        for (size_t i = 0; i < streams.size(); i++)
+            cameras.emplace_back(&LiveRunner::captureLoop, this, i);
+        for (auto& camera : cameras)
+            camera.join();
+        for (auto& worker : workers)
+            worker.get();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    duration = elapsed.count();
+    for (auto& stream : streams)
+    {
+        std::chrono::duration<double> stream_duration = stream.last_result - stream.first_capture;
+        stream.stats.duration = stream.stats.processed > 0 ? stream_duration.count() : 0;
+    }
+}
+
+static void emitLatencies(YAML::Emitter& out, const LatencyHistogram& histogram)
+{
+    out << YAML::BeginMap;
+    out << YAML::Key << "p50" << YAML::Value << histogram.getPercentile(50.0);
+    out << YAML::Key << "p90" << YAML::Value << histogram.getPercentile(90.0);
+    out << YAML::Key << "p99" << YAML::Value << histogram.getPercentile(99.0);
+    out << YAML::Key << "max" << YAML::Value << histogram.getMax();
+    out << YAML::EndMap;
+}
+
+void LiveRunner::saveResults(const std::string& path)
+{
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    out << YAML::Key << "tracker" << YAML::Value << args.tracker;
+    out << YAML::Key << "workers" << YAML::Value << workers_num;
+    out << YAML::Key << "queue_depth" << YAML::Value << args.queue_depth;
+    out << YAML::Key << "max_frame_age" << YAML::Value << args.max_frame_age;
+
+    size_t captured = 0, processed = 0, idle = 0, reinits = 0, dropped_full = 0, dropped_stale = 0;
+    LatencyHistogram processing, latency;
+    out << YAML::Key << "streams" << YAML::Value << YAML::BeginSeq;
+    for (size_t i = 0; i < streams.size(); i++)
+    {
+        const Stream& stream = streams[i];
+        FrameSchedulerStats scheduler_stats = scheduler->getStats(i);
+        out << YAML::BeginMap;
+        out << YAML::Key << "name" << YAML::Value << stream.name;
+        out << YAML::Key << "source_fps" << YAML::Value << stream.stats.source_fps;
+        out << YAML::Key << "captured" << YAML::Value << scheduler_stats.pushed;
+        out << YAML::Key << "processed" << YAML::Value << stream.stats.processed;
+        out << YAML::Key << "idle" << YAML::Value << stream.stats.idle;
+        out << YAML::Key << "reinits" << YAML::Value << stream.stats.reinits;
+        out << YAML::Key << "dropped_full" << YAML::Value << scheduler_stats.dropped_full;
+        out << YAML::Key << "dropped_stale" << YAML::Value << scheduler_stats.dropped_stale;
+        out << YAML::Key << "fps" << YAML::Value << (stream.stats.duration > 0 ? stream.stats.processed / stream.stats.duration : 0.0);
+        out << YAML::Key << "processing" << YAML::Value;
+        emitLatencies(out, stream.stats.processing);
+        out << YAML::Key << "latency" << YAML::Value;
+        emitLatencies(out, stream.stats.latency);
+        out << YAML::EndMap;
+
+        captured += scheduler_stats.pushed;
+        processed += stream.stats.processed;
+        idle += stream.stats.idle;
+        reinits += stream.stats.reinits;
+        dropped_full += scheduler_stats.dropped_full;
+        dropped_stale += scheduler_stats.dropped_stale;
+        processing.merge(stream.stats.processing);
+        latency.merge(stream.stats.latency);
+    }
+    out << YAML::EndSeq;
+
+    double fps = duration > 0 ? processed / duration : 0.0;
+    out << YAML::Key << "aggregate" << YAML::Value << YAML::BeginMap;
+    out << YAML::Key << "duration" << YAML::Value << duration;
+    out << YAML::Key << "captured" << YAML::Value << captured;
+    out << YAML::Key << "processed" << YAML::Value << processed;
+    out << YAML::Key << "idle" << YAML::Value << idle;
+    out << YAML::Key << "reinits" << YAML::Value << reinits;
+    out << YAML::Key << "dropped_full" << YAML::Value << dropped_full;
+    out << YAML::Key << "dropped_stale" << YAML::Value << dropped_stale;
+    out << YAML::Key << "fps" << YAML::Value << fps;
+    out << YAML::Key << "processing" << YAML::Value;
+    emitLatencies(out, processing);
+    out << YAML::Key << "latency" << YAML::Value;
+    emitLatencies(out, latency);
+    out << YAML::EndMap;
+    out << YAML::EndMap;
+
+    std::string live_file_path = path + "/live.yaml";
+    std::ofstream live_file(live_file_path);
+    if (!live_file.is_open())
+    {
+        spdlog::error("Could not open the file: {}", live_file_path);
+        return;
+    }
+    live_file << out.c_str();
+    spdlog::info("Live run: {} of {} frames processed, {:.1f} fps over {} streams, latency p99 {:.1f} ms",
+        processed, captured, fps, streams.size(), latency.getPercentile(99.0) * 1000);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include <yaml-cpp/yaml.h>
+#include "DatasetUtils.hpp"
+#include "VideoReader.hpp"
+#include "ITracker.hpp"
+#include "FrameScheduler.hpp"
+#include "LatencyHistogram.hpp"
+
+struct LiveArgs
+{
+    std::string tracker = "VIT";
+    size_t streams = 0;          // 0 - one stream per sequence, sequences are reused for more
+    size_t workers = 0;          // tracking threads shared by all streams, 0 - one per core
+    size_t queue_depth = 2;      // frames waiting per stream
+    double max_frame_age = 0.1;  // seconds a frame may wait for a worker, 0 - no limit
+    double default_fps = 30;     // for sources which do not know their frame rate
+};
+LiveArgs readLiveArgs(const YAML::Node& config);
+
+struct LiveFrame
+{
+    cv::Mat image;
+    size_t index = 0; // position in the source, to find its annotation
+};
+
+struct LiveStreamStats
+{
+    double source_fps = 0;
+    size_t processed = 0;       // frames the tracker was initialized or updated on, the only ones in fps and latencies
+    size_t idle = 0;            // frames without an annotation to start a lost tracker from, no tracking work done
+    size_t reinits = 0;
+    double duration = 0;        // from the first captured frame to the last result, in seconds
+    LatencyHistogram processing; // tracker update time
+    LatencyHistogram latency;    // from capture to result, waiting in the queue included
+};
+
+// Sequences of a dataset replayed at their native fps as live camera streams, each tracked by its own tracker.
+// Cameras run on their own threads, trackers share a pool of workers fed by a FrameScheduler,
+// so streams which can not be served in time lose frames instead of falling behind.
+class LiveRunner
+{
+public:
+    LiveRunner(const YAML::Node& config);
+    // Creates a tracker for every stream, sequences whose annotations can not be loaded are skipped.
+    // False when no sequence is left or a tracker could not be created
+    bool setup(const std::vector<DatasetInfo>& all_sequences);
+    void run();
+    void saveResults(const std::string& path);
+
+private:
+    struct Stream
+    {
+        std::string name;
+        DatasetInfo dataset_info;
+        std::vector<Annotation> ground_truths;
+        std::unique_ptr<ITracker> tracker;
+        bool initialized = false;
+        std::chrono::steady_clock::time_point first_capture;
+        std::chrono::steady_clock::time_point last_result;
+        LiveStreamStats stats;
+    };
+
+    std::unique_ptr<VideoReader> createReader(const DatasetInfo& dataset_info);
+    void captureLoop(size_t index);
+    void workerLoop();
+    void processFrame(Stream& stream, const FrameScheduler<LiveFrame>::Job& job);
+
+    const YAML::Node& config;
+    LiveArgs args;
+    std::vector<Stream> streams;
+    std::unique_ptr<FrameScheduler<LiveFrame>> scheduler;
+    size_t workers_num = 0;
+    double duration = 0; // whole run, in seconds
+};
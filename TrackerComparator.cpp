@@ -1,6 +1,9 @@
 #include <sstream>
 #include <fstream>
 #include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h> 
 #include "TrackerComparator.hpp"
@@ -8,24 +11,56 @@
 #include "DaSiamTracker.hpp"
 #include "VITTracker.hpp"
 #include "ModVITTracker.hpp"
+#include "ModelSpec.hpp"
+#include "ModelRegistry.hpp"
 #include "DatasetUtils.hpp"
 #include "VideoFileReader.hpp"
 #include "ImageSequenceReader.hpp"
+#include "PrefetchingVideoReader.hpp"
 
 
 TrackerComparator::TrackerComparator(const YAML::Node& config) : config(config)
 {
     parseReinitStrategy(config["reinit_strategy"].as<std::string>());
     if (config["mode"].as<std::string>() == "debug")
+    {
         desired_frame_processing_time = 30;
+        debug_drawing = true;
+    }
     else if (config["mode"].as<std::string>() == "eval")
         desired_frame_processing_time = 1;
+    else if (config["mode"].as<std::string>() == "headless")
+        display_enabled = false;
     else
         spdlog::warn("Unknown mode: {}", config["mode"].as<std::string>());
+    parallel_trackers = config["parallel_trackers"].as<bool>(false);
+    warmup_frames = config["evaluation"]["warmup_frames"].as<unsigned>(0);
+    record_outputs = config["evaluation"]["record_outputs"].as<bool>(false);
+    realtime = config["evaluation"]["realtime"].as<bool>(false);
+    if (realtime && record_outputs)
+    {
+        // replay assumes every frame was given to the tracker
+        spdlog::warn("Outputs are not recorded in real-time mode");
+        record_outputs = false;
+    }
+    results_format = parseResultsFormat(config["evaluation"]["results_format"].as<std::string>("csv"));
 }
 TrackerComparator::~TrackerComparator()
 {
-    video_writer.release();
+    renderer.reset();
+    video_writer.reset();
+}
+
+ResultsFormat parseResultsFormat(const std::string& format)
+{
+    if (format == "csv")
+        return ResultsFormat::Csv;
+    if (format == "columnar")
+        return ResultsFormat::Columnar;
+    if (format == "both")
+        return ResultsFormat::Both;
+    spdlog::warn("Unknown results format: {}, using csv", format);
+    return ResultsFormat::Csv;
 }
 
 void TrackerComparator::parseReinitStrategy(const std::string& strategy)
@@ -44,7 +79,11 @@ void TrackerComparator::loadDataset(const DatasetInfo& d_info)
 {
     dataset_info = d_info;
     spdlog::debug("Dataset info: \n{}", fmt::streamed(dataset_info));
-    if (dataset_info.dataset_type == DatasetType::Custom)
+    if (!dataset_info.annotations.empty())
+    {
+        ground_truths = dataset_info.annotations; // parsed when the dataset index was built
+    }
+    else if (dataset_info.dataset_type == DatasetType::Custom)
     {
         ground_truths = loadCustomAnnotations(dataset_info.ground_truth_paths[0]);
     }
@@ -57,41 +96,214 @@ void TrackerComparator::loadDataset(const DatasetInfo& d_info)
 
 bool TrackerComparator::setupVideoReader()
 {
-
+    CachedVideoReader::SourceFactory create_source;
     if (dataset_info.dataset_type == DatasetType::OTB)
     {
-        video_reader = std::make_unique<ImageSequenceReader>(dataset_info.media_path);
+        ImageSequenceReaderArgs reader_args;
+        if (const YAML::Node& decode_config = config["image_decode"])
+        {
+            reader_args.lookahead = decode_config["lookahead"].as<size_t>(0);
+            reader_args.decode_threads = decode_config["threads"].as<size_t>(reader_args.decode_threads);
+            reader_args.memory_budget_bytes = decode_config["memory_budget_mb"].as<size_t>(512) * 1024 * 1024;
+        }
+        create_source = [this, reader_args]() -> std::unique_ptr<VideoReader> {
+            if (!dataset_info.frame_files.empty())
+                return std::make_unique<ImageSequenceReader>(dataset_info.frame_files, reader_args);
+            return std::make_unique<ImageSequenceReader>(dataset_info.media_path, reader_args);
+        };
     }
     else if (dataset_info.dataset_type == DatasetType::Custom || dataset_info.dataset_type == DatasetType::VideoOnly)
     {
-        video_reader = std::make_unique<VideoFileReader>(dataset_info.media_path);
+        create_source = [this]() -> std::unique_ptr<VideoReader> { return std::make_unique<VideoFileReader>(dataset_info.media_path); };
     }
     else
     {
         spdlog::error("Unknown dataset type");
         return false;
     }
+
+    cached_reader = nullptr;
+    const YAML::Node& cache_config = config["frame_cache"];
+    if (cache_config && cache_config["enabled"].as<bool>(false))
+    {
+        FrameCacheArgs cache_args;
+        cache_args.directory = cache_config["directory"].as<std::string>(cache_args.directory);
+        cache_args.max_bytes = cache_config["max_size_mb"].as<uint64_t>(cache_args.max_bytes / (1024 * 1024)) * 1024 * 1024;
+        auto reader = std::make_unique<CachedVideoReader>(dataset_info.media_path, create_source, cache_args);
+        cached_reader = reader.get();
+        video_reader = std::move(reader);
+    }
+    else
+    {
+        video_reader = create_source();
+    }
+
+    unsigned prefetch_depth = config["prefetch_depth"].as<unsigned>(0);
+    if (prefetch_depth > 0)
+        video_reader = std::make_unique<PrefetchingVideoReader>(std::move(video_reader), prefetch_depth);
     return true;
 }
 
-bool TrackerComparator::setupTrackersAndEvaluators()
+// Keys missing in the node are taken from base
+static ModelSpec readModelSpec(const YAML::Node& node, ModelSpec base)
 {
-    try
+    if (!node)
+        return base;
+    if (node["path"])
+        base.path = node["path"].as<std::string>();
+    if (node["backend"])
+        base.backend = parseDnnBackend(node["backend"].as<std::string>());
+    if (node["target"])
+        base.target = parseDnnTarget(node["target"].as<std::string>());
+    if (node["precision"])
+        base.precision = parseModelPrecision(node["precision"].as<std::string>());
+    if (node["runtime"])
+        base.runtime = node["runtime"].as<std::string>();
+    if (node["threads"])
+        base.threads = node["threads"].as<int>();
+    return base;
+}
+
+std::unique_ptr<ITracker> createTracker(const std::string& name, const YAML::Node& config)
+{
+    const YAML::Node& trackers_config = config["trackers"];
+    if (name == "CSRT")
+        return std::make_unique<CSRTTracker>();
+    if (name == "DaSiam")
+        return std::make_unique<DaSiamTracker>(trackers_config["dasiam"]["score_thresh"].as<double>());
+    const YAML::Node& vit_config = trackers_config["vit"];
+    ModelSpec vit_model = readModelSpec(vit_config["model"], ModelSpec());
+    if (name == "VIT")
+        return std::make_unique<VITTracker>(vit_config["score_thresh"].as<double>(), vit_model);
+    const YAML::Node& modvit_config = trackers_config["modvit"];
+    ModelSpec modvit_model = readModelSpec(modvit_config["model"], ModelSpec());
+    if (name == "ModVIT")
+        return std::make_unique<ModVITTracker>(modvit_config["score_thresh"].as<double>(), modvit_model);
+    const YAML::Node& cache = modvit_config["template_cache"];
+    if (name == "ModVITCached" && cache)
     {
+        // same tracker with the template branch run once per init
+        cv::TrackerModVIT::Params params;
+        params.templateNet = cache["template_net"].as<std::string>();
+        params.searchNet = cache["search_net"].as<std::string>();
+        if (cache["features"])
+            params.templateFeatures = cache["features"].as<std::vector<std::string>>();
+        return std::make_unique<ModVITTracker>(modvit_config["score_thresh"].as<double>(), params, name);
+    }
+    for (const auto& variant : vit_config["variants"])
+    {
+        if (variant["name"].as<std::string>() == name)
+            return std::make_unique<VITTracker>(vit_config["score_thresh"].as<double>(), readModelSpec(variant, vit_model), name);
+    }
+    for (const auto& variant : modvit_config["variants"])
+    {
+        if (variant["name"].as<std::string>() == name)
+            return std::make_unique<ModVITTracker>(modvit_config["score_thresh"].as<double>(), readModelSpec(variant, modvit_model), name);
+    }
+    spdlog::error("Unknown tracker: {}", name);
+    return nullptr;
+}
 
-        trackers.push_back(std::make_unique<CSRTTracker>());
-        trackers.push_back(std::make_unique<DaSiamTracker>(config["trackers"]["dasiam"]["score_thresh"].as<double>()));
-        trackers.push_back(std::make_unique<VITTracker>(config["trackers"]["vit"]["score_thresh"].as<double>()));
-        trackers.push_back(std::make_unique<ModVITTracker>(config["trackers"]["modvit"]["score_thresh"].as<double>()));
+bool TrackerComparator::setupTrackers()
+{
+    // trackers and their models outlive a sequence, they are only re-initialized on the next one
+    trackers_reused = !trackers.empty();
+    if (trackers_reused)
+        return true;
+
+    try
+    {
+        auto checkpoint = std::chrono::steady_clock::now();
+        auto addTracker = [&](const std::string& name) {
+            std::unique_ptr<ITracker> tracker = createTracker(name, config);
+            if (!tracker)
+                throw std::runtime_error("Could not create " + name);
+            trackers.push_back(std::move(tracker));
+            auto now = std::chrono::steady_clock::now();
+            std::chrono::duration<double> elapsed = now - checkpoint;
+            tracker_load_times.push_back(elapsed.count());
+            checkpoint = now;
+        };
+
+        warmed_up = false;
+        addTracker("CSRT");
+        addTracker("DaSiam");
+        int vit_index = trackers.size();
+        addTracker("VIT");
+        int modvit_index = trackers.size();
+        addTracker("ModVIT");
+        // evaluated side by side with ModVIT for A/B latency
+        if (config["trackers"]["modvit"]["template_cache"])
+            addTracker("ModVITCached");
+        // each variant runs next to its baseline on the same frames, so the cost of a lower precision is measured directly
+        const YAML::Node& vit_config = config["trackers"]["vit"];
+        ModelSpec vit_model = readModelSpec(vit_config["model"], ModelSpec());
+        for (const auto& variant : vit_config["variants"])
+        {
+            model_variants.push_back(ModelVariant{ (int)trackers.size(), vit_index, readModelSpec(variant, vit_model) });
+            addTracker(variant["name"].as<std::string>());
+        }
+        const YAML::Node& modvit_config = config["trackers"]["modvit"];
+        ModelSpec modvit_model = readModelSpec(modvit_config["model"], ModelSpec());
+        for (const auto& variant : modvit_config["variants"])
+        {
+            model_variants.push_back(ModelVariant{ (int)trackers.size(), modvit_index, readModelSpec(variant, modvit_model) });
+            addTracker(variant["name"].as<std::string>());
+        }
         colors = std::vector<cv::Scalar>({ cv::Scalar(255, 50, 150), cv::Scalar(255, 0, 0), cv::Scalar(0, 255, 0), cv::Scalar(200, 170, 255) });
+        while (colors.size() < trackers.size())
+            colors.push_back(cv::Scalar(0, 140, 255));
+        if (parallel_trackers && trackers.size() > 1)
+            tracker_pool = std::make_unique<ThreadPool>(trackers.size());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        // never reuse a partially created set
+        trackers.clear();
+        model_variants.clear();
+        tracker_load_times.clear();
+        return false;
+    }
+}
+
+TrackerPerformanceEvaluatorArgs TrackerComparator::readEvaluatorArgs()
+{
+    TrackerPerformanceEvaluatorArgs args;
+    args.overlap_thresh = config["evaluation"]["overlap_thresh"].as<double>();
+    args.center_error_thresh = config["evaluation"]["center_error_thresh"].as<double>();
+    args.deadline = config["evaluation"]["deadline_ms"].as<double>(args.deadline * 1000) / 1000;
+    args.cold_start_frames = config["evaluation"]["cold_start_frames"].as<unsigned>(args.cold_start_frames);
+    return args;
+}
 
-        TrackerPerformanceEvaluatorArgs args;
-        args.overlap_thresh = config["evaluation"]["overlap_thresh"].as<double>();
-        args.center_error_thresh = config["evaluation"]["center_error_thresh"].as<double>();
+bool TrackerComparator::setupEvaluators()
+{
+    try
+    {
+        TrackerPerformanceEvaluatorArgs args = readEvaluatorArgs();
+        // trackers created for an earlier sequence are warm already, their first frames are no cold start
+        if (trackers_reused)
+            args.cold_start_frames = 0;
+        if (realtime)
+        {
+            // the source pace is the deadline, the configured one is used when the source does not know its fps
+            double source_fps = video_reader->getFps();
+            frame_interval = source_fps > 0 ? 1.0 / source_fps : args.deadline;
+            args.deadline = frame_interval;
+            args.realtime = true;
+            realtime_clocks.assign(trackers.size(), RealtimeClock());
+        }
         for (const auto& t : trackers)
         {
             args.tracker_name = t->getName();
             evaluators.push_back(std::make_unique<TrackerPerformanceEvaluator>(args));
+            if (record_outputs)
+            {
+                recordings.emplace_back();
+                recordings.back().tracker_name = t->getName();
+            }
         }
         return true;
     }
@@ -112,19 +324,43 @@ unsigned TrackerComparator::calcWaitTime()
 
 void TrackerComparator::setupVideoWriter(const std::string& instance_results_dir)
 {
-    int codec = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
-    video_writer.open(instance_results_dir + "/video.mp4", codec, 25, cv::Size(1280, 720), true);
+    AsyncVideoWriterArgs writer_args;
+    writer_args.path = instance_results_dir + "/video.mp4";
+    double source_fps = video_reader->getFps();
+    if (source_fps > 0)
+        writer_args.fps = source_fps;
+
+    // unset values follow the source stream
+    if (const YAML::Node& output_config = config["video_output"])
+    {
+        writer_args.codec = output_config["codec"].as<std::string>(writer_args.codec);
+        double fps = output_config["fps"].as<double>(0);
+        if (fps > 0)
+            writer_args.fps = fps;
+        writer_args.frame_size = cv::Size(output_config["width"].as<int>(0), output_config["height"].as<int>(0));
+        writer_args.queue_size = output_config["queue_size"].as<size_t>(writer_args.queue_size);
+        writer_args.full_policy = parseQueueFullPolicy(output_config["full_policy"].as<std::string>("block"));
+    }
+    video_writer = std::make_unique<AsyncVideoWriter>(writer_args);
 }
 
 
 bool TrackerComparator::setupComponents(const std::string& instance_results_dir)
 {
 
-    if (setupVideoReader() && setupTrackersAndEvaluators())
+    if (setupVideoReader() && setupTrackers() && setupEvaluators())
     {
         if (config["save_video"].as<bool>() && !instance_results_dir.empty())
             setupVideoWriter(instance_results_dir);
 
+        if (display_enabled || video_writer)
+        {
+            FrameRendererArgs renderer_args;
+            renderer_args.show_window = display_enabled;
+            renderer_args.frame_time_ms = desired_frame_processing_time;
+            renderer = std::make_unique<FrameRenderer>(renderer_args, video_writer.get());
+        }
+
         return true;
     }
 
@@ -133,12 +369,23 @@ bool TrackerComparator::setupComponents(const std::string& instance_results_dir)
 
 void TrackerComparator::reset() {
     dataset_info = DatasetInfo();
+    renderer.reset();
+    video_writer.reset();
     video_reader.reset();
-    trackers.clear();
+    cached_reader = nullptr;
+    for (auto& t : trackers)
+        t->reset();
     evaluators.clear();
+    recordings.clear();
+    realtime_clocks.clear();
     ground_truths.clear();
 }
 
+void TrackerComparator::setDisplayEnabled(bool enabled)
+{
+    display_enabled = enabled;
+}
+
 bool TrackerComparator::readFirstFrameAndInit()
 {
     frame_count = 0;
@@ -148,12 +395,23 @@ bool TrackerComparator::readFirstFrameAndInit()
         {
             convertGTToNonNormalized(frame.cols, frame.rows);
         }
+        if (!warmed_up && warmup_frames > 0)
+            warmUpTrackers();
         for (auto& t : trackers)
         {
             t->init(frame, ground_truths[frame_count].rect);
         }
-        cv::rectangle(frame, ground_truths[frame_count].rect, cv::Scalar(0, 255, 255), 2, 1);
-        video_writer.write(frame);
+        // the first frame arrives at time zero, initialization is not timed
+        for (auto& clock : realtime_clocks)
+            clock = RealtimeClock();
+        if (renderer)
+        {
+            RenderJob job;
+            job.frame = frame.clone();
+            job.ground_truth = ground_truths[frame_count].rect;
+            job.annotations_only = true;
+            renderer->submit(std::move(job));
+        }
         frame_count++;
     }
     else
@@ -164,12 +422,18 @@ bool TrackerComparator::readFirstFrameAndInit()
     return true;
 }
 
+// Whether a tracker which is not lost gets reinitialized after a frame, the same rule is applied to replayed outputs
+bool TrackerComparator::wouldReinit(ValidationStatus valid_status, int occluded)
+{
+    return valid_status != ValidationStatus::Valid && reinit_strategy == ReinitStrategy::Immediate && occluded != 1;
+}
+
 bool TrackerComparator::applyReinitStrategy(const cv::Mat& frame, int index, ValidationStatus reason)
 {
 
     if (reinit_strategy == ReinitStrategy::Immediate)
     {
-        if (ground_truths[frame_count].occluded != 1)
+        if (wouldReinit(reason, ground_truths[frame_count].occluded))
         {
             spdlog::debug("Try to apply reninit strategy to tracker {}, reason {}", trackers[index]->getName(), ValidationStatusToString(reason));
             trackers[index]->init(frame, ground_truths[frame_count].rect);
@@ -184,6 +448,118 @@ bool TrackerComparator::applyReinitStrategy(const cv::Mat& frame, int index, Val
     return false;
 }
 
+std::vector<double> TrackerComparator::warmUpTracker(int index)
+{
+    // lazy allocations and graph setup happen here, on the first frame, outside of the timed loop
+    std::vector<double> times;
+    cv::Rect bbox;
+    trackers[index]->init(frame, ground_truths[frame_count].rect);
+    for (unsigned i = 0; i < warmup_frames; i++)
+    {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        trackers[index]->update(frame, bbox);
+        std::chrono::duration<double> processing_time = std::chrono::high_resolution_clock::now() - start_time;
+        times.push_back(processing_time.count());
+    }
+    trackers[index]->reset();
+    return times;
+}
+
+void TrackerComparator::warmUpTrackers()
+{
+    // same threads as the timed loop, so thread local state is warmed up too
+    std::vector<std::future<std::vector<double>>> pending;
+    for (int i = 0; i < trackers.size(); i++)
+    {
+        if (tracker_pool)
+            pending.push_back(tracker_pool->submit([this, i] { return warmUpTracker(i); }));
+        else
+            evaluators[i]->setWarmupTimes(warmUpTracker(i));
+    }
+    for (int i = 0; i < pending.size(); i++)
+        evaluators[i]->setWarmupTimes(pending[i].get());
+    if (record_outputs)
+    {
+        // the evaluator keeps only the first cold_start_frames, which is all the replay needs
+        for (int i = 0; i < evaluators.size(); i++)
+            recordings[i].warmup_times = evaluators[i]->getWarmupTimes();
+    }
+    warmed_up = true;
+    spdlog::info("Trackers warmed up on {} frames", warmup_frames);
+}
+
+TrackerStepResult TrackerComparator::updateAndEvaluateTracker(int index)
+{
+    TrackerStepResult step;
+    if (realtime && !realtime_clocks[index].isFrameDue(frame_count, frame_interval))
+    {
+        const RealtimeClock& clock = realtime_clocks[index];
+        step.bbox = clock.last_bbox;
+        step.skipped = true;
+        step.valid_status = evaluators[index]->addSkippedResult(ground_truths[frame_count].rect, step.bbox, trackers[index]->getState() == TrackerState::Lost);
+        return step;
+    }
+    bool updated = false;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    if (trackers[index]->getState() != TrackerState::Lost && trackers[index]->getState() != TrackerState::ToBeReinited)
+    {
+        trackers[index]->update(frame, step.bbox);
+        updated = true;
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> processing_time = end_time - start_time;
+    step.valid_status = evaluators[index]->validateAndAddResult(ground_truths[frame_count].rect, step.bbox, processing_time.count(), trackers[index]->getState() == TrackerState::Lost);
+    if (realtime)
+        realtime_clocks[index].update(frame_count, frame_interval, processing_time.count(), step.bbox);
+    StageTimings stage_timings;
+    if (updated)
+    {
+        stage_timings = trackers[index]->getStageTimings();
+        evaluators[index]->addStageTimes(stage_timings);
+    }
+    if (record_outputs)
+    {
+        TrackerRecording& recording = recordings[index];
+        RecordedFrame record;
+        record.ground_truth = ground_truths[frame_count].rect;
+        record.occluded = ground_truths[frame_count].occluded;
+        record.updated = updated;
+        record.bbox = step.bbox;
+        record.score = trackers[index]->getTrackingScore();
+        record.state = stateToString(trackers[index]->getState());
+        record.processing_time = processing_time.count();
+        if (recording.stage_names.empty())
+        {
+            for (const auto& stage : stage_timings)
+                recording.stage_names.push_back(stage.first);
+        }
+        for (const auto& stage : stage_timings)
+            record.stage_times.push_back(stage.second);
+        recording.frames.push_back(std::move(record));
+    }
+    return step;
+}
+
+std::vector<TrackerStepResult> TrackerComparator::updateAndEvaluateTrackers()
+{
+    std::vector<TrackerStepResult> steps(trackers.size());
+    if (!tracker_pool)
+    {
+        for (int i = 0; i < trackers.size(); i++)
+            steps[i] = updateAndEvaluateTracker(i);
+        return steps;
+    }
+
+    // Every tracker only touches its own evaluator, the frame is shared read-only
+    std::vector<std::future<TrackerStepResult>> pending;
+    pending.reserve(trackers.size());
+    for (int i = 0; i < trackers.size(); i++)
+        pending.push_back(tracker_pool->submit([this, i] { return updateAndEvaluateTracker(i); }));
+    for (int i = 0; i < trackers.size(); i++)
+        steps[i] = pending[i].get();
+    return steps;
+}
+
 void TrackerComparator::runEvaluation()
 {
     if (!readFirstFrameAndInit())
@@ -193,65 +569,69 @@ void TrackerComparator::runEvaluation()
     {
         if (video_reader->getNextFrame(frame))
         {
-            start_frame_processing_time = std::chrono::steady_clock::now();
-            cv::Mat frame_vis = frame.clone();
             if (frame_count >= ground_truths.size())
             {
                 spdlog::error("Ground truth vector size exceeded");
                 break;
             }
-            cv::rectangle(frame_vis, ground_truths[frame_count].rect, cv::Scalar(0, 255, 255), 2, 1);
 
-            for (int i = 0; i < trackers.size(); i++)
+            // frames are copied and annotated only when someone is going to look at them
+            RenderJob job;
+            if (renderer)
             {
-                cv::Rect bbox;
+                job.frame = frame.clone();
+                job.ground_truth = ground_truths[frame_count].rect;
+                job.occluded = ground_truths[frame_count].occluded;
+            }
 
-                auto start_time = std::chrono::high_resolution_clock::now();
-                if (trackers[i]->getState() != TrackerState::Lost && trackers[i]->getState() != TrackerState::ToBeReinited)
-                    trackers[i]->update(frame, bbox);
-                auto end_time = std::chrono::high_resolution_clock::now();
-                std::chrono::duration<double> processing_time = end_time - start_time;
-                ValidationStatus valid_status = evaluators[i]->validateAndAddResult(ground_truths[frame_count].rect, bbox, processing_time.count(), trackers[i]->getState() == TrackerState::Lost);
+            std::vector<TrackerStepResult> steps = updateAndEvaluateTrackers();
+            for (int i = 0; i < trackers.size(); i++)
+            {
+                ValidationStatus valid_status = steps[i].valid_status;
 
                 bool tracking_valid = (trackers[i]->getState() == TrackerState::Tracking);
                 bool tracking_reinited = false;
                 if (valid_status != ValidationStatus::Valid && trackers[i]->getState() != TrackerState::Lost)
                 {
                     tracking_valid = false;
-                    tracking_reinited = applyReinitStrategy(frame, i, valid_status);
+                    // a busy tracker can only be reinitialized once it takes a frame again
+                    if (!steps[i].skipped)
+                        tracking_reinited = applyReinitStrategy(frame, i, valid_status);
                 }
+                if (record_outputs)
+                    recordings[i].frames.back().reinited = tracking_reinited;
 
-                auto color = tracking_valid ? colors[i] : cv::Scalar(0, 0, 255);
-                if (bbox.area() > 0)
+                if (renderer)
                 {
-                    cv::putText(frame_vis, trackers[i]->getName(), cv::Point(bbox.x + bbox.width + 5, bbox.y + 17 * i), cv::FONT_HERSHEY_SIMPLEX, 0.5, color,
-                        2);
-                    cv::rectangle(frame_vis, bbox, color, 2, 1);
+                    TrackerOverlay overlay;
+                    overlay.name = trackers[i]->getName();
+                    overlay.bbox = steps[i].bbox;
+                    overlay.color = tracking_valid ? colors[i] : cv::Scalar(0, 0, 255);
+                    overlay.valid = tracking_valid;
+                    overlay.info = trackers[i]->getName() + " : " + stateToString(trackers[i]->getState()) + " " + std::to_string(trackers[i]->getTrackingScore());
+                    if (tracking_reinited)
+                        overlay.info += " REINITED";
+                    if (steps[i].skipped)
+                        overlay.info += " BUSY";
+                    if (debug_drawing)
+                        overlay.debug_boxes = trackers[i]->getDebugBoxes();
+                    job.trackers.push_back(std::move(overlay));
                 }
-
-                std::string state_str = stateToString(trackers[i]->getState());
-                cv::Scalar state_color = tracking_valid ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 0, 255);
-                std::string tracker_info_str = trackers[i]->getName() + " : " + state_str + " " + std::to_string(trackers[i]->getTrackingScore());
-                if (tracking_reinited)
-                    tracker_info_str += " REINITED";
-                    
-                cv::putText(frame_vis,
-                    tracker_info_str,
-                    cv::Point(10, (frame_vis.rows - 20) - 30 * i), cv::FONT_HERSHEY_SIMPLEX, 0.5, state_color, 2);
             }
-            cv::putText(frame_vis,
-                "OCCLUSION: " + std::to_string(ground_truths[frame_count].occluded),
-                cv::Point(10, (frame_vis.rows - 20) - 30 * trackers.size()), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 255, 0), 2);
 
-
-            video_writer.write(frame_vis);
-            cv::imshow("Frame", frame_vis);
-            unsigned to_wait = calcWaitTime();
-            if (cv::waitKey(to_wait) == 'q')
-                break; // Press any key to exit
+            if (renderer)
+            {
+                renderer->submit(std::move(job));
+                if (renderer->quitRequested())
+                    break; // Press q in the preview window to exit
+            }
             frame_count++;
         }
     }
+    if (renderer)
+        renderer->finish();
+    if (video_writer)
+        video_writer->finish();
 }
 
 void TrackerComparator::runPreview(const std::string& tracker_name)
@@ -317,6 +697,24 @@ void TrackerComparator::runPreview(const std::string& tracker_name)
 }
 
 
+void TrackerComparator::saveTrackerResults(const TrackerPerformanceEvaluator& evaluator, const std::string& path_prefix)
+{
+    if (results_format != ResultsFormat::Columnar)
+        evaluator.saveResultsToFile(path_prefix + "_results.csv");
+    if (results_format != ResultsFormat::Csv)
+        evaluator.saveResultsToColumnarFile(path_prefix + "_results.tcr");
+}
+
+// null when either tracker has no timed frames, eg. it was lost on the first one
+static void emitSpeedup(YAML::Emitter& out, const std::string& key, double baseline_time, double variant_time)
+{
+    out << YAML::Key << key << YAML::Value;
+    if (baseline_time > 0 && variant_time > 0)
+        out << baseline_time / variant_time;
+    else
+        out << YAML::Null;
+}
+
 void TrackerComparator::saveResults(const std::string& path)
 {
 
@@ -331,13 +729,92 @@ void TrackerComparator::saveResults(const std::string& path)
     YAML::Emitter out;
     out << YAML::BeginMap;
 
+    std::vector<SequenceTrackingSummary> summaries;
     for (int i = 0; i < trackers.size(); i++)
     {
         auto tracker_name = trackers[i]->getName();
-        std::string filename = path + "/" + tracker_name + "_results.csv";
-        evaluators[i]->saveResultsToFile(filename);
-        auto summary = evaluators[i]->getTrackingSummary();
-        out << YAML::Key << tracker_name << YAML::Value << summary;
+        saveTrackerResults(*evaluators[i], path + "/" + tracker_name);
+        summaries.push_back(evaluators[i]->getTrackingSummary());
+        out << YAML::Key << tracker_name << YAML::Value << summaries.back();
+    }
+    if (record_outputs)
+        saveRecordings(path);
+    // creation cost of the trackers, paid once per comparator and not again for reused ones
+    double total_load_time = 0;
+    out << YAML::Key << "model_load" << YAML::Value << YAML::BeginMap;
+    out << YAML::Key << "reused" << YAML::Value << trackers_reused;
+    out << YAML::Key << "trackers" << YAML::Value << YAML::BeginMap;
+    for (int i = 0; i < tracker_load_times.size(); i++)
+    {
+        out << YAML::Key << trackers[i]->getName() << YAML::Value << tracker_load_times[i];
+        total_load_time += tracker_load_times[i];
+    }
+    out << YAML::EndMap;
+    out << YAML::Key << "time" << YAML::Value << total_load_time;
+    ModelRegistryStats registry_stats = ModelRegistry::instance().getStats();
+    out << YAML::Key << "mapped_models" << YAML::Value << registry_stats.models;
+    out << YAML::Key << "mapped_bytes" << YAML::Value << registry_stats.mapped_bytes;
+    out << YAML::Key << "shared_hits" << YAML::Value << registry_stats.shared_hits;
+    out << YAML::EndMap;
+    if (!model_variants.empty())
+    {
+        // positive speedup above 1 is a gain, negative overlap and success rate diffs are the accuracy cost
+        out << YAML::Key << "model_variants" << YAML::Value << YAML::BeginMap;
+        for (const auto& model_variant : model_variants)
+        {
+            int variant = model_variant.tracker_index;
+            int baseline = model_variant.baseline_index;
+            const SequenceTrackingSummary& variant_summary = summaries[variant];
+            const SequenceTrackingSummary& baseline_summary = summaries[baseline];
+            out << YAML::Key << trackers[variant]->getName() << YAML::Value << YAML::BeginMap;
+            out << YAML::Key << "baseline" << YAML::Value << trackers[baseline]->getName();
+            out << YAML::Key << "precision" << YAML::Value << precisionToString(model_variant.model.precision);
+            emitSpeedup(out, "avg_time_speedup", baseline_summary.avg_time, variant_summary.avg_time);
+            emitSpeedup(out, "time_p50_speedup", baseline_summary.time_p50, variant_summary.time_p50);
+            emitSpeedup(out, "time_p99_speedup", baseline_summary.time_p99, variant_summary.time_p99);
+            out << YAML::Key << "avg_overlap_diff" << YAML::Value << variant_summary.avg_overlap - baseline_summary.avg_overlap;
+            out << YAML::Key << "success_rt_diff" << YAML::Value << variant_summary.success_rt - baseline_summary.success_rt;
+            out << YAML::Key << "reinit_cnt_diff" << YAML::Value << (int)variant_summary.reinit_cnt - (int)baseline_summary.reinit_cnt;
+            out << YAML::EndMap;
+        }
+        out << YAML::EndMap;
+    }
+    if (video_writer)
+    {
+        VideoWriterStats stats = video_writer->getStats();
+        if (stats.frames_dropped > 0)
+            spdlog::warn("Video writer dropped {} frames", stats.frames_dropped);
+        out << YAML::Key << "video_writer" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "frames_written" << YAML::Value << stats.frames_written;
+        out << YAML::Key << "frames_dropped" << YAML::Value << stats.frames_dropped;
+        out << YAML::Key << "frames_resized" << YAML::Value << stats.frames_resized;
+        out << YAML::EndMap;
+    }
+    if (cached_reader)
+    {
+        FrameCacheStats stats = cached_reader->getStats();
+        spdlog::info("Frame cache: {}, {} frames, {} entries evicted", stats.hit ? "hit" : (stats.stored ? "stored" : "not stored"),
+            stats.frames, stats.evicted_entries);
+        out << YAML::Key << "frame_cache" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "hit" << YAML::Value << stats.hit;
+        out << YAML::Key << "stored" << YAML::Value << stats.stored;
+        out << YAML::Key << "frames" << YAML::Value << stats.frames;
+        out << YAML::Key << "entry_bytes" << YAML::Value << stats.entry_bytes;
+        out << YAML::Key << "evicted_entries" << YAML::Value << stats.evicted_entries;
+        out << YAML::Key << "evicted_bytes" << YAML::Value << stats.evicted_bytes;
+        out << YAML::EndMap;
+    }
+    if (auto prefetcher = dynamic_cast<PrefetchingVideoReader*>(video_reader.get()))
+    {
+        PrefetchStats stats = prefetcher->getStats();
+        spdlog::info("Frame prefetch: {} frames, {} consumer stalls ({} s), {} decoder waits",
+            stats.frames_delivered, stats.consumer_stalls, stats.consumer_stall_time, stats.producer_waits);
+        out << YAML::Key << "frame_prefetch" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "frames" << YAML::Value << stats.frames_delivered;
+        out << YAML::Key << "consumer_stalls" << YAML::Value << stats.consumer_stalls;
+        out << YAML::Key << "consumer_stall_time" << YAML::Value << stats.consumer_stall_time;
+        out << YAML::Key << "decoder_waits" << YAML::Value << stats.producer_waits;
+        out << YAML::EndMap;
     }
     out << YAML::EndMap;
     summary_file << out.c_str();
@@ -346,6 +823,117 @@ void TrackerComparator::saveResults(const std::string& path)
 }
 
 
+void TrackerComparator::saveRecordings(const std::string& path)
+{
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    out << YAML::Key << "reinit_strategy" << YAML::Value << config["reinit_strategy"].as<std::string>();
+    out << YAML::Key << "evaluation" << YAML::Value << config["evaluation"];
+    out << YAML::Key << "trackers_reused" << YAML::Value << trackers_reused;
+    out << YAML::Key << "trackers" << YAML::Value << YAML::BeginMap;
+    for (const auto& recording : recordings)
+    {
+        std::string filename = recording.tracker_name + "_record.csv";
+        try
+        {
+            recording.saveToFile(path + "/" + filename);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Recording of {} not saved: {}", recording.tracker_name, e.what());
+            continue;
+        }
+        out << YAML::Key << recording.tracker_name << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "file" << YAML::Value << filename;
+        out << YAML::Key << "warmup_times" << YAML::Value << YAML::Flow << recording.warmup_times;
+        out << YAML::EndMap;
+    }
+    out << YAML::EndMap;
+    out << YAML::EndMap;
+    std::ofstream record_file(path + "/record.yaml");
+    record_file << out.c_str();
+}
+
+std::vector<ReplayDivergence> TrackerComparator::replayRecording(const std::string& recorded_dir, const std::string& results_dir)
+{
+    std::vector<ReplayDivergence> divergences;
+    YAML::Node record = YAML::LoadFile(recorded_dir + "/record.yaml");
+    TrackerPerformanceEvaluatorArgs args = readEvaluatorArgs();
+    if (record["trackers_reused"].as<bool>(false))
+        args.cold_start_frames = 0;
+
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    for (const auto& tracker_record : record["trackers"])
+    {
+        args.tracker_name = tracker_record.first.as<std::string>();
+        TrackerRecording recording = TrackerRecording::loadFromFile(recorded_dir + "/" + tracker_record.second["file"].as<std::string>());
+        TrackerPerformanceEvaluator evaluator(args);
+        auto warmup_times = tracker_record.second["warmup_times"].as<std::vector<double>>(std::vector<double>());
+        if (!warmup_times.empty())
+            evaluator.setWarmupTimes(warmup_times);
+
+        // the loop of runEvaluation, with the tracker outputs taken from the recording
+        bool lost = false;
+        std::string divergence;
+        size_t i = 0;
+        for (; i < recording.frames.size(); i++)
+        {
+            const RecordedFrame& frame = recording.frames[i];
+            if (!lost && !frame.updated)
+            {
+                divergence = "tracker was lost in the recording and has no outputs";
+                break;
+            }
+            ValidationStatus valid_status = evaluator.validateAndAddResult(frame.ground_truth, frame.bbox, frame.processing_time, lost);
+            if (!lost && !recording.stage_names.empty())
+            {
+                StageTimings stage_timings;
+                for (size_t j = 0; j < recording.stage_names.size() && j < frame.stage_times.size(); j++)
+                    stage_timings.emplace_back(recording.stage_names[j], frame.stage_times[j]);
+                evaluator.addStageTimes(stage_timings);
+            }
+            if (lost)
+                continue; // nothing recorded is used past the loss
+            bool reinited = wouldReinit(valid_status, frame.occluded);
+            if (reinited != frame.reinited)
+            {
+                divergence = reinited ? "tracker would be reinitialized" : "tracker was reinitialized in the recording";
+                break;
+            }
+            if (reinited)
+                evaluator.trackingReinited();
+            else if (valid_status != ValidationStatus::Valid && reinit_strategy == ReinitStrategy::OneInit)
+                lost = true;
+        }
+        if (!divergence.empty())
+        {
+            spdlog::warn("Replay of {} in {} diverges at frame {}: {}", args.tracker_name, recorded_dir, i + 1, divergence);
+            divergences.push_back({ args.tracker_name, i + 1, divergence });
+            continue;
+        }
+
+        saveTrackerResults(evaluator, results_dir + "/" + args.tracker_name);
+        out << YAML::Key << args.tracker_name << YAML::Value << evaluator.getTrackingSummary();
+    }
+    out << YAML::Key << "replay" << YAML::Value << YAML::BeginMap;
+    out << YAML::Key << "source" << YAML::Value << recorded_dir;
+    out << YAML::Key << "diverged" << YAML::Value << YAML::BeginMap;
+    for (const auto& divergence : divergences)
+    {
+        out << YAML::Key << divergence.tracker_name << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "frame" << YAML::Value << divergence.frame;
+        out << YAML::Key << "reason" << YAML::Value << divergence.reason;
+        out << YAML::EndMap;
+    }
+    out << YAML::EndMap;
+    out << YAML::EndMap;
+    out << YAML::EndMap;
+    std::ofstream summary_file(results_dir + "/summary.yaml");
+    summary_file << out.c_str();
+    return divergences;
+}
+
 void TrackerComparator::loadVideoOnlyDataset(const std::string& path)
 {
     dataset_info.media_path = path;
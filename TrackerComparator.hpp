@@ -4,8 +4,15 @@
 #include <yaml-cpp/yaml.h>
 #include "DatasetUtils.hpp"
 #include "VideoReader.hpp"
+#include "CachedVideoReader.hpp"
 #include "ITracker.hpp"
+#include "ModelSpec.hpp"
 #include "TrackerPerformanceEvaluator.hpp"
+#include "RealtimeClock.hpp"
+#include "TrackerRecording.hpp"
+#include "ThreadPool.hpp"
+#include "FrameRenderer.hpp"
+#include "AsyncVideoWriter.hpp"
 
 // Compare strategies
 // Reset imidiately after loss, count resets and avg tracking time
@@ -21,6 +28,43 @@ enum class ReinitStrategy
     OneInit
 };
 
+// Per-frame results files, <tracker>_results.csv and/or <tracker>_results.tcr
+enum class ResultsFormat
+{
+    Csv,
+    Columnar,
+    Both
+};
+ResultsFormat parseResultsFormat(const std::string& format);
+
+// Single tracker configured like in a comparison, by its name (CSRT, DaSiam, VIT, ModVIT, ModVITCached when
+// trackers.modvit.template_cache is set, or the name of a vit/modvit variant), nullptr for an unknown name
+std::unique_ptr<ITracker> createTracker(const std::string& name, const YAML::Node& config);
+
+// Outcome of a single tracker update on the current frame
+struct TrackerStepResult
+{
+    cv::Rect bbox;
+    ValidationStatus valid_status = ValidationStatus::Valid;
+    bool skipped = false; // real-time mode, the tracker was still busy with an earlier frame
+};
+
+// Tracker evaluated with another model than its baseline, compared with it in the summary
+struct ModelVariant
+{
+    int tracker_index;
+    int baseline_index;
+    ModelSpec model;
+};
+
+// Tracker of a replayed sequence whose recorded outputs do not cover the new thresholds, the sequence has to be run again
+struct ReplayDivergence
+{
+    std::string tracker_name;
+    size_t frame; // first frame handled differently, numbered as in the results files
+    std::string reason;
+};
+
 
 class TrackerComparator
 {
@@ -33,24 +77,47 @@ public:
     void runEvaluation();
     void runPreview(const std::string & tracker_name);
     void saveResults(const std::string & path);
+    // Evaluates the outputs recorded in recorded_dir under the current thresholds, writes the results to results_dir
+    std::vector<ReplayDivergence> replayRecording(const std::string& recorded_dir, const std::string& results_dir);
     void reset();
+    void setDisplayEnabled(bool enabled);
 private:
     bool readFirstFrameAndInit();
     bool setupVideoReader();
-    bool setupTrackersAndEvaluators();
+    bool setupTrackers();
+    bool setupEvaluators();
+    TrackerPerformanceEvaluatorArgs readEvaluatorArgs();
+    bool wouldReinit(ValidationStatus valid_status, int occluded);
+    void saveRecordings(const std::string& path);
+    void saveTrackerResults(const TrackerPerformanceEvaluator& evaluator, const std::string& path_prefix);
     void setupVideoWriter(const std::string& instance_results_dir);
     void convertGTToNonNormalized(int imgWidth, int imgHeight);
     void parseReinitStrategy(const std::string& strategy);
     bool applyReinitStrategy(const cv::Mat& frame, int index, ValidationStatus valid_status);
     unsigned calcWaitTime();
+    std::vector<double> warmUpTracker(int index);
+    void warmUpTrackers();
+    TrackerStepResult updateAndEvaluateTracker(int index);
+    std::vector<TrackerStepResult> updateAndEvaluateTrackers();
 
     DatasetInfo dataset_info;
     std::unique_ptr<VideoReader> video_reader;
-    cv::VideoWriter video_writer;
+    CachedVideoReader* cached_reader = nullptr; // owned by video_reader, possibly behind the prefetcher
+    std::unique_ptr<AsyncVideoWriter> video_writer;
+    std::unique_ptr<FrameRenderer> renderer; // only exists when frames are displayed or recorded
     std::vector<Annotation> ground_truths;
     std::vector<std::unique_ptr<ITracker>> trackers;
     std::vector<std::unique_ptr<TrackerPerformanceEvaluator>> evaluators;
+    std::vector<TrackerRecording> recordings; // raw tracker outputs, only when record_outputs is enabled
+    std::vector<RealtimeClock> realtime_clocks; // only in real-time mode
+    double frame_interval = 0; // seconds between frames of the source in real-time mode
     std::vector<cv::Scalar> colors;
+    std::vector<ModelVariant> model_variants;
+    std::vector<double> tracker_load_times; // creation time of each tracker including its models, in seconds
+    bool trackers_reused = false; // trackers of the current sequence were created for an earlier one
+    unsigned warmup_frames = 0;
+    bool warmed_up = false; // trackers ran their untimed warm-up, done once after they are created
+    std::unique_ptr<ThreadPool> tracker_pool; // one worker per tracker, only in parallel mode
     cv::Mat frame;
     std::chrono::time_point<std::chrono::steady_clock> start_frame_processing_time;
     unsigned int desired_frame_processing_time = 0;
@@ -58,6 +125,12 @@ private:
 
     const YAML::Node& config;
     ReinitStrategy reinit_strategy;
+    bool parallel_trackers = false;
+    bool record_outputs = false;
+    bool realtime = false; // trackers only get the newest frame when they become free, like a live camera
+    ResultsFormat results_format = ResultsFormat::Csv;
+    bool display_enabled = true;
+    bool debug_drawing = false; // draw intermediate tracker boxes, debug mode only
 
 };
 
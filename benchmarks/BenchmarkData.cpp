@@ -0,0 +1,116 @@
+#include "BenchmarkData.hpp"
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace fs = std::filesystem;
+
+cv::Size frameSizeFor(int64_t height)
+{
+    return cv::Size(static_cast<int>(height * 16 / 9), static_cast<int>(height));
+}
+
+cv::Mat makeFrame(cv::Size size)
+{
+    cv::Mat frame(size, CV_8UC3);
+    cv::RNG rng(42);
+    rng.fill(frame, cv::RNG::UNIFORM, 0, 256);
+    return frame;
+}
+
+cv::Rect centeredBox(cv::Size frame_size, int64_t side)
+{
+    int s = static_cast<int>(side);
+    return cv::Rect((frame_size.width - s) / 2, (frame_size.height - s) / 2, s, s);
+}
+
+namespace {
+
+struct TemporaryDirectory
+{
+    fs::path path;
+    TemporaryDirectory() : path(fs::temp_directory_path() / "trackers_compare_benchmarks")
+    {
+        fs::create_directories(path);
+    }
+    ~TemporaryDirectory()
+    {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+// generated files by name, each is only written once
+std::string cached(const std::string& name, void (*write)(const std::string&, cv::Size, int), cv::Size size, int count)
+{
+    static std::map<std::string, std::string> files;
+    auto it = files.find(name);
+    if (it != files.end())
+        return it->second;
+    std::string path = (fs::path(benchmarkDir()) / name).string();
+    write(path, size, count);
+    files[name] = path;
+    return path;
+}
+
+}
+
+std::string benchmarkDir()
+{
+    static TemporaryDirectory dir;
+    return dir.path.string();
+}
+
+std::string makeVideo(cv::Size size, int frames)
+{
+    std::string name = "video_" + std::to_string(size.height) + "_" + std::to_string(frames) + ".mp4";
+    return cached(name, [](const std::string& path, cv::Size size, int frames) {
+        cv::VideoWriter writer(path, cv::VideoWriter::fourcc('m', 'p', '4', 'v'), 30, size);
+        cv::Mat frame = makeFrame(size);
+        for (int i = 0; i < frames; i++)
+        {
+            cv::Mat shifted;
+            cv::Matx23d shift(1, 0, i, 0, 1, 0); // slow pan, frames differ like in a real clip
+            cv::warpAffine(frame, shifted, shift, size, cv::INTER_NEAREST, cv::BORDER_WRAP);
+            writer.write(shifted);
+        }
+        }, size, frames);
+}
+
+std::string makeImageSequence(cv::Size size, int frames)
+{
+    std::string name = "img_" + std::to_string(size.height) + "_" + std::to_string(frames);
+    return cached(name, [](const std::string& path, cv::Size size, int frames) {
+        fs::create_directories(path);
+        cv::Mat frame = makeFrame(size);
+        for (int i = 0; i < frames; i++)
+        {
+            char file[16];
+            std::snprintf(file, sizeof(file), "%04d.jpg", i + 1);
+            cv::imwrite((fs::path(path) / file).string(), frame);
+        }
+        }, size, frames);
+}
+
+std::string makeOTBAnnotations(int lines)
+{
+    return cached("otb_" + std::to_string(lines) + ".txt", [](const std::string& path, cv::Size, int lines) {
+        std::ofstream file(path);
+        for (int i = 0; i < lines; i++)
+            file << 100 + i % 50 << "," << 80 + i % 30 << "," << 64 << "," << 48 << "\n";
+        }, cv::Size(), lines);
+}
+
+std::string makeCustomAnnotations(int lines)
+{
+    return cached("custom_" + std::to_string(lines) + ".txt", [](const std::string& path, cv::Size, int lines) {
+        std::ofstream file(path);
+        for (int i = 0; i < lines; i++)
+        {
+            if (i % 10 == 9)
+                file << i << "\n"; // frames without the target
+            else
+                file << i << "," << 0.5 + (i % 20) * 0.001 << "," << 0.4 << "," << 0.05 << "," << 0.08 << "," << (i % 7 == 0) << "\n";
+        }
+        }, cv::Size(), lines);
+}
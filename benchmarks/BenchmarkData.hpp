@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <opencv2/opencv.hpp>
+
+// Frame heights the benchmarks are parameterized with, widths follow a 16:9 aspect ratio
+const std::vector<int64_t> benchmark_frame_heights = { 480, 720, 1080 };
+// Sides of the square target box in pixels
+const std::vector<int64_t> benchmark_box_sizes = { 32, 96, 256 };
+
+cv::Size frameSizeFor(int64_t height);
+// Deterministic noise frame, so every run measures the same pixels
+cv::Mat makeFrame(cv::Size size);
+// Box of the given side centered in the frame
+cv::Rect centeredBox(cv::Size frame_size, int64_t side);
+
+// Files generated once per process in a temporary directory, removed at exit
+std::string benchmarkDir();
+std::string makeVideo(cv::Size size, int frames);
+std::string makeImageSequence(cv::Size size, int frames);
+std::string makeOTBAnnotations(int lines);
+std::string makeCustomAnnotations(int lines);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "DatasetUtils.hpp"
+#include "VideoFileReader.hpp"
+#include "ImageSequenceReader.hpp"
+#include "PrefetchingVideoReader.hpp"
+
+static void BM_LoadOTBAnnotations(benchmark::State& state)
+{
+    std::string path = makeOTBAnnotations(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto annotations = loadOTBAnnotations(path);
+        benchmark::DoNotOptimize(annotations.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadOTBAnnotations)->Arg(1000)->Arg(100000)->ArgName("lines");
+
+static void BM_LoadCustomAnnotations(benchmark::State& state)
+{
+    std::string path = makeCustomAnnotations(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto annotations = loadCustomAnnotations(path);
+        benchmark::DoNotOptimize(annotations.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadCustomAnnotations)->Arg(1000)->Arg(100000)->ArgName("lines");
+
+namespace {
+
+const int sequence_frames = 60;
+
+// Reads a whole sequence per iteration, opening the reader is not measured
+template <typename CreateReader>
+void readAllFrames(benchmark::State& state, CreateReader create)
+{
+    cv::Mat frame;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::unique_ptr<VideoReader> reader = create();
+        state.ResumeTiming();
+        while (reader->getNextFrame(frame))
+            benchmark::DoNotOptimize(frame.data);
+        state.PauseTiming();
+        reader.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * sequence_frames);
+}
+
+}
+
+static void BM_VideoFileReader(benchmark::State& state)
+{
+    std::string path = makeVideo(frameSizeFor(state.range(0)), sequence_frames);
+    readAllFrames(state, [&]() { return std::make_unique<VideoFileReader>(path); });
+}
+BENCHMARK(BM_VideoFileReader)->ArgsProduct({ benchmark_frame_heights })->ArgNames({ "height" })->Unit(benchmark::kMillisecond);
+
+static void BM_ImageSequenceReader(benchmark::State& state)
+{
+    std::string path = makeImageSequence(frameSizeFor(state.range(0)), sequence_frames);
+    ImageSequenceReaderArgs args;
+    args.lookahead = state.range(1);
+    readAllFrames(state, [&]() { return std::make_unique<ImageSequenceReader>(path, args); });
+}
+BENCHMARK(BM_ImageSequenceReader)->ArgsProduct({ benchmark_frame_heights, { 0, 8 } })->ArgNames({ "height", "lookahead" })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PrefetchingVideoReader(benchmark::State& state)
+{
+    std::string path = makeVideo(frameSizeFor(state.range(0)), sequence_frames);
+    readAllFrames(state, [&]() { return std::make_unique<PrefetchingVideoReader>(std::make_unique<VideoFileReader>(path), 4); });
+}
+BENCHMARK(BM_PrefetchingVideoReader)->ArgsProduct({ benchmark_frame_heights })->ArgNames({ "height" })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
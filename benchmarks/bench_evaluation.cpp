@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "TrackerPerformanceEvaluator.hpp"
+
+namespace {
+
+// Tracking results drifting around the ground truth, with some lost frames
+struct TrackingRun
+{
+    std::vector<cv::Rect> ground_truths;
+    std::vector<cv::Rect> results;
+    std::vector<double> times;
+    std::vector<bool> lost;
+
+    TrackingRun(int frames, int64_t box_side)
+    {
+        cv::RNG rng(3);
+        cv::Rect box = centeredBox(frameSizeFor(720), box_side);
+        for (int i = 0; i < frames; i++)
+        {
+            ground_truths.push_back(box + cv::Point(i % 50, i % 30));
+            results.push_back(ground_truths.back() + cv::Point(rng.uniform(-10, 10), rng.uniform(-10, 10)));
+            times.push_back(rng.uniform(0.005, 0.05));
+            lost.push_back(i % 97 == 0);
+        }
+    }
+};
+
+}
+
+static void BM_ValidateAndAddResult(benchmark::State& state)
+{
+    TrackingRun run(static_cast<int>(state.range(0)), state.range(1));
+    TrackerPerformanceEvaluatorArgs args;
+    args.tracker_name = "Benchmark";
+    spdlog::set_level(spdlog::level::warn);
+    for (auto _ : state)
+    {
+        TrackerPerformanceEvaluator evaluator(args);
+        for (size_t i = 0; i < run.results.size(); i++)
+            benchmark::DoNotOptimize(evaluator.validateAndAddResult(run.ground_truths[i], run.results[i], run.times[i], run.lost[i]));
+    }
+    state.SetItemsProcessed(state.iterations() * run.results.size());
+}
+BENCHMARK(BM_ValidateAndAddResult)->ArgsProduct({ { 1000, 10000 }, benchmark_box_sizes })->ArgNames({ "frames", "box" });
+
+static void BM_TrackingSummary(benchmark::State& state)
+{
+    TrackingRun run(static_cast<int>(state.range(0)), 96);
+    TrackerPerformanceEvaluatorArgs args;
+    args.tracker_name = "Benchmark";
+    spdlog::set_level(spdlog::level::warn);
+    TrackerPerformanceEvaluator evaluator(args);
+    for (size_t i = 0; i < run.results.size(); i++)
+        evaluator.validateAndAddResult(run.ground_truths[i], run.results[i], run.times[i], run.lost[i]);
+
+    for (auto _ : state)
+    {
+        SequenceTrackingSummary summary = evaluator.getTrackingSummary();
+        benchmark::DoNotOptimize(summary.avg_time);
+    }
+}
+BENCHMARK(BM_TrackingSummary)->Arg(1000)->Arg(10000)->ArgName("frames");
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "ModVITPreprocess.hpp"
+#include "ModVITPostprocess.hpp"
+
+namespace {
+
+const cv::Scalar meanvalue{ 0.485, 0.456, 0.406 };
+const cv::Scalar stdvalue{ 0.229, 0.224, 0.225 };
+
+// Network output with a few peaks, as produced for a target near the crop center
+void makeNetworkOutput(cv::Mat& conf_map, cv::Mat& size_map, cv::Mat& offset_map, int64_t box_side)
+{
+    cv::RNG rng(7);
+    conf_map.create(16, 16, CV_32F);
+    rng.fill(conf_map, cv::RNG::UNIFORM, 0.0, 0.2);
+    conf_map.at<float>(8, 8) = 0.9f;
+    conf_map.at<float>(8, 9) = 0.8f;
+    conf_map.at<float>(7, 8) = 0.75f;
+
+    const int sizes[] = { 2, 16, 16 };
+    size_map.create(3, sizes, CV_32F);
+    offset_map.create(3, sizes, CV_32F);
+    // sizes are relative to the search crop, four times the box side
+    size_map.setTo(0.25 + box_side * 1e-4);
+    rng.fill(offset_map, cv::RNG::UNIFORM, 0.0, 1.0);
+}
+
+}
+
+static void BM_CropResizedPatch(benchmark::State& state)
+{
+    cv::Size frame_size = frameSizeFor(state.range(0));
+    cv::Mat frame = makeFrame(frame_size);
+    cv::Rect box = centeredBox(frame_size, state.range(1));
+    cv::Mat patch;
+    for (auto _ : state)
+    {
+        cv::modvit::cropResizedPatch(frame, patch, box, 4, cv::Size(256, 256));
+        benchmark::DoNotOptimize(patch.data);
+    }
+}
+BENCHMARK(BM_CropResizedPatch)->ArgsProduct({ benchmark_frame_heights, benchmark_box_sizes })->ArgNames({ "height", "box" });
+
+static void BM_NormalizeToBlob(benchmark::State& state)
+{
+    int side = static_cast<int>(state.range(0));
+    cv::Mat patch = makeFrame(cv::Size(side, side));
+    cv::modvit::NormalizationConstants constants(meanvalue, stdvalue);
+    cv::Mat blob;
+    for (auto _ : state)
+    {
+        cv::modvit::normalizeToBlob(patch, blob, constants);
+        benchmark::DoNotOptimize(blob.data);
+    }
+    state.SetItemsProcessed(state.iterations() * side * side);
+}
+// template and search patch sizes
+BENCHMARK(BM_NormalizeToBlob)->Arg(128)->Arg(256)->ArgName("patch");
+
+// crop and preprocess of one update, the whole input path of the network
+static void BM_CropAndNormalize(benchmark::State& state)
+{
+    cv::Size frame_size = frameSizeFor(state.range(0));
+    cv::Mat frame = makeFrame(frame_size);
+    cv::Rect box = centeredBox(frame_size, state.range(1));
+    cv::modvit::NormalizationConstants constants(meanvalue, stdvalue);
+    cv::Mat patch, blob;
+    for (auto _ : state)
+    {
+        cv::modvit::cropResizedPatch(frame, patch, box, 4, cv::Size(256, 256));
+        cv::modvit::normalizeToBlob(patch, blob, constants);
+        benchmark::DoNotOptimize(blob.data);
+    }
+}
+BENCHMARK(BM_CropAndNormalize)->ArgsProduct({ benchmark_frame_heights, benchmark_box_sizes })->ArgNames({ "height", "box" });
+
+static void BM_Hann2d(benchmark::State& state)
+{
+    int side = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        cv::Mat window = cv::modvit::hann2d(cv::Size(side, side), false);
+        benchmark::DoNotOptimize(window.data);
+    }
+}
+BENCHMARK(BM_Hann2d)->Arg(16)->Arg(32)->ArgName("size");
+
+static void BM_TopCandidatesFusion(benchmark::State& state)
+{
+    cv::Mat conf_map, size_map, offset_map;
+    makeNetworkOutput(conf_map, size_map, offset_map, state.range(0));
+    cv::Mat window = cv::modvit::hann2d(cv::Size(16, 16), false);
+    cv::multiply(conf_map, (1.0 - window), conf_map);
+    cv::Rect last = centeredBox(frameSizeFor(720), state.range(0));
+
+    cv::Mat scratch;
+    std::vector<cv::Rect> rects;
+    std::vector<double> scores;
+    for (auto _ : state)
+    {
+        cv::modvit::findTopCandidates(conf_map, size_map, offset_map, last, 5, scratch, rects, scores);
+        int best = cv::modvit::fuseCandidates(rects, scores);
+        benchmark::DoNotOptimize(best);
+    }
+}
+BENCHMARK(BM_TopCandidatesFusion)->ArgsProduct({ benchmark_box_sizes })->ArgNames({ "box" });
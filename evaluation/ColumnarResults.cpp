@@ -0,0 +1,188 @@
+#include "ColumnarResults.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <yaml-cpp/yaml.h>
+#include "MappedFile.hpp"
+
+namespace
+{
+
+const char results_magic[8] = { 'T', 'C', 'R', 'E', 'S', 'U', 'L', 'T' };
+const uint32_t results_version = 1;
+const size_t column_alignment = 64;
+const size_t prefix_bytes = sizeof(results_magic) + 2 * sizeof(uint32_t);
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + column_alignment - 1) / column_alignment * column_alignment;
+}
+
+std::string jsonString(const std::string& text)
+{
+    std::string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            quoted += '\\';
+        if (static_cast<unsigned char>(c) < 0x20)
+            continue; // control characters never appear in names
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+bool isLittleEndian()
+{
+    uint16_t value = 1;
+    return *reinterpret_cast<const uint8_t*>(&value) == 1;
+}
+
+}
+
+void ColumnarResultsWriter::setAttribute(const std::string& key, const std::string& value)
+{
+    attributes.emplace_back(key, value);
+}
+
+void ColumnarResultsWriter::save(const std::string& filename) const
+{
+    if (!isLittleEndian())
+        throw std::runtime_error("Columnar results are only written on little endian machines");
+
+    // offsets depend on the header length and the header holds the offsets, so the header is sized first with
+    // offsets of the widest possible length
+    auto buildHeader = [&](uint64_t data_offset, int offset_width) {
+        std::ostringstream header;
+        header << "{\"version\": " << results_version << ", \"rows\": " << rows;
+        for (const auto& attribute : attributes)
+            header << ", " << jsonString(attribute.first) << ": " << jsonString(attribute.second);
+        header << ", \"columns\": [";
+        uint64_t offset = data_offset;
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            std::string offset_text = std::to_string(offset);
+            offset_text.insert(0, std::max<int>(0, offset_width - (int)offset_text.size()), ' ');
+            header << (i > 0 ? ", " : "") << "{\"name\": " << jsonString(columns[i].name) << ", \"dtype\": \"" << columns[i].dtype
+                << "\", \"offset\": " << offset_text << "}";
+            offset = alignUp(offset + columns[i].bytes.size());
+        }
+        header << "]}";
+        return header.str();
+    };
+    const int offset_width = 20;
+    uint64_t data_offset = alignUp(prefix_bytes + buildHeader(0, offset_width).size() + 1);
+    std::string header = buildHeader(data_offset, offset_width);
+    header.resize(data_offset - prefix_bytes - 1, ' ');
+    header += '\n';
+
+    std::string tmp_path = filename + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            throw std::runtime_error("Could not open the file: " + tmp_path);
+        uint32_t offset32 = static_cast<uint32_t>(data_offset);
+        out.write(results_magic, sizeof(results_magic));
+        out.write(reinterpret_cast<const char*>(&results_version), sizeof(results_version));
+        out.write(reinterpret_cast<const char*>(&offset32), sizeof(offset32));
+        out.write(header.data(), header.size());
+        static const char padding[column_alignment] = {};
+        for (const auto& column : columns)
+        {
+            out.write(column.bytes.data(), column.bytes.size());
+            out.write(padding, alignUp(column.bytes.size()) - column.bytes.size());
+        }
+        if (!out.good())
+            throw std::runtime_error("Writing " + tmp_path + " failed");
+    }
+    std::filesystem::rename(tmp_path, filename);
+}
+
+ColumnarResultsReader::ColumnarResultsReader(const std::string& filename) : file(std::make_unique<MappedFile>(filename))
+{
+    std::string_view data = file->view();
+    if (!file->isOpen())
+        throw std::runtime_error("Could not open the file: " + filename);
+    if (data.size() < prefix_bytes || std::memcmp(data.data(), results_magic, sizeof(results_magic)) != 0)
+        throw std::runtime_error(filename + ": not a columnar results file");
+    uint32_t version, data_offset;
+    std::memcpy(&version, data.data() + sizeof(results_magic), sizeof(version));
+    std::memcpy(&data_offset, data.data() + sizeof(results_magic) + sizeof(version), sizeof(data_offset));
+    if (version != results_version)
+        throw std::runtime_error(filename + ": unsupported version " + std::to_string(version));
+    if (data_offset < prefix_bytes || data_offset > data.size())
+        throw std::runtime_error(filename + ": truncated header");
+
+    // JSON is a subset of YAML
+    YAML::Node header;
+    try
+    {
+        header = YAML::Load(std::string(data.substr(prefix_bytes, data_offset - prefix_bytes)));
+        rows = header["rows"].as<size_t>();
+        for (const auto& column : header["columns"])
+            columns.push_back({ column["name"].as<std::string>(), column["dtype"].as<std::string>(), column["offset"].as<uint64_t>() });
+        for (const auto& entry : header)
+        {
+            std::string key = entry.first.as<std::string>();
+            if (entry.second.IsScalar() && key != "version" && key != "rows")
+                attributes.emplace_back(key, entry.second.as<std::string>());
+        }
+    }
+    catch (const YAML::Exception& e)
+    {
+        throw std::runtime_error(filename + ": malformed header, " + e.what());
+    }
+
+    for (const auto& column : columns)
+    {
+        if (column.dtype.size() != 3 || column.dtype[2] < '1' || column.dtype[2] > '8')
+            throw std::runtime_error(filename + ": column " + column.name + " has unknown type " + column.dtype);
+        size_t element_size = column.dtype[2] - '0';
+        if (column.offset > data.size() || (data.size() - column.offset) / element_size < rows)
+            throw std::runtime_error(filename + ": column " + column.name + " is truncated");
+    }
+}
+
+ColumnarResultsReader::~ColumnarResultsReader() = default;
+
+std::vector<std::string> ColumnarResultsReader::getColumnNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& column : columns)
+        names.push_back(column.name);
+    return names;
+}
+
+std::string ColumnarResultsReader::getAttribute(const std::string& key) const
+{
+    for (const auto& attribute : attributes)
+    {
+        if (attribute.first == key)
+            return attribute.second;
+    }
+    return "";
+}
+
+bool ColumnarResultsReader::hasColumn(const std::string& name) const
+{
+    for (const auto& column : columns)
+    {
+        if (column.name == name)
+            return true;
+    }
+    return false;
+}
+
+const void* ColumnarResultsReader::getColumnData(const std::string& name, const std::string& dtype) const
+{
+    for (const auto& column : columns)
+    {
+        if (column.name != name)
+            continue;
+        if (column.dtype != dtype)
+            throw std::runtime_error("Column " + name + " has type " + column.dtype + ", requested " + dtype);
+        return file->view().data() + column.offset;
+    }
+    throw std::runtime_error("No column " + name);
+}
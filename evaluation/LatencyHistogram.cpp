@@ -0,0 +1,140 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+static unsigned highestBit(uint64_t value)
+{
+  unsigned bit = 0;
+  while (value >>= 1)
+    bit++;
+  return bit;
+}
+
+LatencyHistogram::LatencyHistogram(unsigned precision_bits) : precision_bits(precision_bits)
+{
+  if (precision_bits < 2 || precision_bits > 16)
+    throw std::invalid_argument("LatencyHistogram precision must be in range [2, 16] bits");
+  sub_bucket_count = uint64_t(1) << precision_bits;
+}
+
+// Values below sub_bucket_count get their own bucket, above that every power of two
+// range [2^m, 2^(m+1)) is split into sub_bucket_count / 2 equal buckets
+size_t LatencyHistogram::bucketIndex(uint64_t value_us) const
+{
+  if (value_us < sub_bucket_count)
+    return value_us;
+  unsigned shift = highestBit(value_us) - (precision_bits - 1);
+  uint64_t half = sub_bucket_count / 2;
+  return sub_bucket_count + (shift - 1) * half + ((value_us >> shift) - half);
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(size_t index) const
+{
+  if (index < sub_bucket_count)
+    return index;
+  uint64_t half = sub_bucket_count / 2;
+  uint64_t shift = (index - sub_bucket_count) / half + 1;
+  uint64_t sub_bucket = (index - sub_bucket_count) % half + half;
+  return sub_bucket << shift;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) const
+{
+  return bucketLowerBound(index + 1) - 1;
+}
+
+void LatencyHistogram::record(double seconds)
+{
+  if (seconds < 0)
+    return;
+  uint64_t value_us = static_cast<uint64_t>(std::llround(seconds * 1e6));
+  size_t index = bucketIndex(value_us);
+  if (index >= counts.size())
+    counts.resize(index + 1, 0);
+  counts[index]++;
+  total_count++;
+  max_us = std::max(max_us, value_us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  if (other.precision_bits != precision_bits)
+    throw std::invalid_argument("Can not merge latency histograms of different precision");
+  if (other.counts.size() > counts.size())
+    counts.resize(other.counts.size(), 0);
+  for (size_t i = 0; i < other.counts.size(); i++)
+    counts[i] += other.counts[i];
+  total_count += other.total_count;
+  max_us = std::max(max_us, other.max_us);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+  return total_count;
+}
+
+double LatencyHistogram::getPercentile(double p) const
+{
+  if (total_count == 0)
+    return 0.0;
+  p = std::clamp(p, 0.0, 100.0);
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * total_count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts.size(); i++)
+  {
+    seen += counts[i];
+    if (seen >= rank)
+      return std::min(bucketUpperBound(i), max_us) * 1e-6;
+  }
+  return max_us * 1e-6;
+}
+
+double LatencyHistogram::getMax() const
+{
+  return max_us * 1e-6;
+}
+
+double LatencyHistogram::getFractionAbove(double seconds) const
+{
+  if (total_count == 0)
+    return 0.0;
+  uint64_t threshold_us = static_cast<uint64_t>(std::llround(std::max(0.0, seconds) * 1e6));
+  uint64_t above = 0;
+  for (size_t i = bucketIndex(threshold_us) + 1; i < counts.size(); i++)
+    above += counts[i];
+  return static_cast<double>(above) / total_count;
+}
+
+LatencyHistogram LatencyHistogram::fromYAML(const YAML::Node& node)
+{
+  LatencyHistogram histogram(node["precision_bits"].as<unsigned>());
+  for (const auto& bucket : node["buckets"])
+  {
+    size_t index = bucket[0].as<size_t>();
+    uint64_t count = bucket[1].as<uint64_t>();
+    if (index >= histogram.counts.size())
+      histogram.counts.resize(index + 1, 0);
+    histogram.counts[index] += count;
+    histogram.total_count += count;
+  }
+  histogram.max_us = node["max_us"].as<uint64_t>(0);
+  return histogram;
+}
+
+YAML::Emitter& operator<<(YAML::Emitter& out, const LatencyHistogram& histogram)
+{
+  out << YAML::BeginMap;
+  out << YAML::Key << "precision_bits" << YAML::Value << histogram.getPrecisionBits();
+  out << YAML::Key << "max_us" << YAML::Value << static_cast<uint64_t>(std::llround(histogram.getMax() * 1e6));
+  out << YAML::Key << "buckets" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+  const auto& counts = histogram.getCounts();
+  for (size_t i = 0; i < counts.size(); i++)
+  {
+    if (counts[i] > 0)
+      out << YAML::Flow << YAML::BeginSeq << i << counts[i] << YAML::EndSeq;
+  }
+  out << YAML::EndSeq;
+  out << YAML::EndMap;
+  return out;
+}
@@ -0,0 +1,16 @@
+#include "RealtimeClock.hpp"
+#include <algorithm>
+#include <cmath>
+
+bool RealtimeClock::isFrameDue(unsigned frame, double frame_interval) const
+{
+  unsigned newest = static_cast<unsigned>(std::floor(free_at / frame_interval + 1e-9));
+  return std::max(last_frame + 1, newest) == frame;
+}
+
+void RealtimeClock::update(unsigned frame, double frame_interval, double processing_time, const cv::Rect& bbox)
+{
+  free_at = std::max(free_at, frame * frame_interval) + processing_time;
+  last_frame = frame;
+  last_bbox = bbox;
+}
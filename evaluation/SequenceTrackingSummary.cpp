@@ -9,8 +9,83 @@ YAML::Emitter& operator<<(YAML::Emitter& out, const SequenceTrackingSummary& sum
     out << YAML::Key << "avg_cle_std" << YAML::Value << summary.avg_cle_std;
     out << YAML::Key << "avg_time" << YAML::Value << summary.avg_time;
     out << YAML::Key << "avg_time_std" << YAML::Value << summary.avg_time_std;
+    out << YAML::Key << "time_p50" << YAML::Value << summary.time_p50;
+    out << YAML::Key << "time_p90" << YAML::Value << summary.time_p90;
+    out << YAML::Key << "time_p99" << YAML::Value << summary.time_p99;
+    out << YAML::Key << "time_p999" << YAML::Value << summary.time_p999;
+    out << YAML::Key << "time_max" << YAML::Value << summary.time_max;
+    out << YAML::Key << "deadline" << YAML::Value << summary.deadline;
+    out << YAML::Key << "deadline_miss_rt" << YAML::Value << summary.deadline_miss_rt;
+    out << YAML::Key << "deadline_miss_cnt" << YAML::Value << summary.deadline_miss_cnt;
     out << YAML::Key << "SR" << YAML::Value << summary.success_rt;
     out << YAML::Key << "RC" << YAML::Value << summary.reinit_cnt;
+    out << YAML::Key << "frames" << YAML::Value << summary.frames;
+    out << YAML::Key << "valid_frames" << YAML::Value << summary.valid_frames;
+    out << YAML::Key << "timed_frames" << YAML::Value << summary.timed_frames;
+    if (!summary.avg_stage_times.empty())
+    {
+        out << YAML::Key << "avg_stage_time" << YAML::Value << YAML::BeginMap;
+        for (const auto& stage : summary.avg_stage_times)
+            out << YAML::Key << stage.first << YAML::Value << stage.second;
+        out << YAML::EndMap;
+    }
+    if (summary.realtime)
+    {
+        out << YAML::Key << "realtime" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "skipped_frames" << YAML::Value << summary.skipped_frames;
+        out << YAML::Key << "skipped_rt" << YAML::Value << (summary.frames > 0 ? summary.skipped_frames / static_cast<double>(summary.frames) : 0.0);
+        out << YAML::EndMap;
+    }
+    if (summary.cold_start_frames > 0)
+    {
+        out << YAML::Key << "cold_start" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "source" << YAML::Value << (summary.cold_start_warmup ? "warmup" : "timed");
+        out << YAML::Key << "frames" << YAML::Value << summary.cold_start_frames;
+        out << YAML::Key << "first_call_time" << YAML::Value << summary.first_call_time;
+        out << YAML::Key << "first_n_time" << YAML::Value << summary.first_n_time;
+        out << YAML::EndMap;
+    }
+    out << YAML::Key << "latency_histogram" << YAML::Value << summary.latency_histogram;
     out << YAML::EndMap;
     return out;
-}
\ No newline at end of file
+}
+SequenceTrackingSummary summaryFromYAML(const YAML::Node& node)
+{
+    SequenceTrackingSummary summary;
+    summary.avg_overlap = node["avg_overlap"].as<double>();
+    summary.avg_overlap_std = node["avg_overlap_std"].as<double>();
+    summary.avg_cle = node["avg_cle"].as<double>();
+    summary.avg_cle_std = node["avg_cle_std"].as<double>();
+    summary.avg_time = node["avg_time"].as<double>();
+    summary.avg_time_std = node["avg_time_std"].as<double>();
+    summary.time_p50 = node["time_p50"].as<double>(0);
+    summary.time_p90 = node["time_p90"].as<double>(0);
+    summary.time_p99 = node["time_p99"].as<double>(0);
+    summary.time_p999 = node["time_p999"].as<double>(0);
+    summary.time_max = node["time_max"].as<double>(0);
+    summary.deadline = node["deadline"].as<double>(0);
+    summary.deadline_miss_rt = node["deadline_miss_rt"].as<double>(0);
+    summary.deadline_miss_cnt = node["deadline_miss_cnt"].as<unsigned>(0);
+    if (const YAML::Node& realtime = node["realtime"])
+    {
+        summary.realtime = true;
+        summary.skipped_frames = realtime["skipped_frames"].as<size_t>(0);
+    }
+    summary.success_rt = node["SR"].as<double>();
+    summary.reinit_cnt = node["RC"].as<unsigned>();
+    summary.frames = node["frames"].as<size_t>(0);
+    summary.valid_frames = node["valid_frames"].as<size_t>(0);
+    summary.timed_frames = node["timed_frames"].as<size_t>(summary.valid_frames);
+    for (const auto& stage : node["avg_stage_time"])
+        summary.avg_stage_times.emplace_back(stage.first.as<std::string>(), stage.second.as<double>());
+    if (const YAML::Node& cold_start = node["cold_start"])
+    {
+        summary.cold_start_warmup = cold_start["source"].as<std::string>("") == "warmup";
+        summary.cold_start_frames = cold_start["frames"].as<size_t>(0);
+        summary.first_call_time = cold_start["first_call_time"].as<double>(0);
+        summary.first_n_time = cold_start["first_n_time"].as<double>(0);
+    }
+    if (const YAML::Node& histogram = node["latency_histogram"])
+        summary.latency_histogram = LatencyHistogram::fromYAML(histogram);
+    return summary;
+}
@@ -0,0 +1,106 @@
+#include "SummaryAccumulator.hpp"
+#include <algorithm>
+#include <cmath>
+
+void SummaryAccumulator::Moments::merge(const Moments& other)
+{
+    if (other.count == 0)
+        return;
+    uint64_t total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+    count = total;
+}
+
+double SummaryAccumulator::Moments::getStd() const
+{
+    return count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+}
+
+SummaryAccumulator::Moments SummaryAccumulator::fromSummary(uint64_t count, double mean, double std)
+{
+    Moments moments;
+    moments.count = count;
+    moments.mean = count > 0 ? mean : 0.0;
+    moments.m2 = count > 1 ? std * std * (count - 1) : 0.0;
+    return moments;
+}
+
+void SummaryAccumulator::add(const SequenceTrackingSummary& summary)
+{
+    sequences++;
+    frames += summary.frames;
+    valid_frames += summary.valid_frames;
+    timed_frames += summary.timed_frames;
+    reinit_cnt += summary.reinit_cnt;
+    overlap.merge(fromSummary(summary.valid_frames, summary.avg_overlap, summary.avg_overlap_std));
+    error.merge(fromSummary(summary.valid_frames, summary.avg_cle, summary.avg_cle_std));
+    time.merge(fromSummary(summary.timed_frames, summary.avg_time, summary.avg_time_std));
+    // deadline misses are counted over the same frames as the histogram
+    deadline_misses += std::llround(summary.deadline_miss_rt * summary.latency_histogram.getCount());
+    deadline = summary.deadline;
+    skipped_frames += summary.skipped_frames;
+    realtime = realtime || summary.realtime;
+    latency_histogram.merge(summary.latency_histogram);
+    for (const auto& stage : summary.avg_stage_times)
+    {
+        if (stage_time_sums.count(stage.first) == 0)
+            stage_names.push_back(stage.first);
+        stage_time_sums[stage.first] += stage.second * summary.timed_frames;
+    }
+}
+
+void SummaryAccumulator::merge(const SummaryAccumulator& other)
+{
+    sequences += other.sequences;
+    frames += other.frames;
+    valid_frames += other.valid_frames;
+    timed_frames += other.timed_frames;
+    reinit_cnt += other.reinit_cnt;
+    overlap.merge(other.overlap);
+    error.merge(other.error);
+    time.merge(other.time);
+    deadline_misses += other.deadline_misses;
+    skipped_frames += other.skipped_frames;
+    realtime = realtime || other.realtime;
+    if (other.sequences > 0)
+        deadline = other.deadline;
+    latency_histogram.merge(other.latency_histogram);
+    for (const auto& name : other.stage_names)
+    {
+        if (stage_time_sums.count(name) == 0)
+            stage_names.push_back(name);
+        stage_time_sums[name] += other.stage_time_sums.at(name);
+    }
+}
+
+SequenceTrackingSummary SummaryAccumulator::getSummary() const
+{
+    SequenceTrackingSummary summary;
+    summary.avg_overlap = overlap.mean;
+    summary.avg_overlap_std = overlap.getStd();
+    summary.avg_cle = error.mean;
+    summary.avg_cle_std = error.getStd();
+    summary.avg_time = time.mean;
+    summary.avg_time_std = time.getStd();
+    summary.time_p50 = latency_histogram.getPercentile(50.0);
+    summary.time_p90 = latency_histogram.getPercentile(90.0);
+    summary.time_p99 = latency_histogram.getPercentile(99.0);
+    summary.time_p999 = latency_histogram.getPercentile(99.9);
+    summary.time_max = latency_histogram.getMax();
+    summary.deadline = deadline;
+    summary.deadline_miss_rt = latency_histogram.getCount() > 0 ? deadline_misses / static_cast<double>(latency_histogram.getCount()) : 0.0;
+    summary.success_rt = frames > 0 ? valid_frames / static_cast<double>(frames) : 0.0;
+    summary.reinit_cnt = reinit_cnt;
+    summary.deadline_miss_cnt = deadline_misses;
+    summary.realtime = realtime;
+    summary.skipped_frames = skipped_frames;
+    summary.frames = frames;
+    summary.valid_frames = valid_frames;
+    summary.timed_frames = timed_frames;
+    summary.latency_histogram = latency_histogram;
+    for (const auto& name : stage_names)
+        summary.avg_stage_times.emplace_back(name, timed_frames > 0 ? stage_time_sums.at(name) / timed_frames : 0.0);
+    return summary;
+}
@@ -1,8 +1,10 @@
 #include "TrackerPerformanceEvaluator.hpp"
+#include "ColumnarResults.hpp"
 #include <fstream>
 #include <numeric>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 
 std::string ValidationStatusToString(ValidationStatus status)
 {
@@ -15,11 +17,20 @@ std::string ValidationStatusToString(ValidationStatus status)
   return map[status];
 }
 
+// Frames whose processing and stage times make up the steady-state statistics
+static bool isTimed(const FrameResult& result)
+{
+  return result.valid && !result.skipped && !result.cold_start;
+}
+
 TrackerPerformanceEvaluator::TrackerPerformanceEvaluator(const TrackerPerformanceEvaluatorArgs& args)
 {
   tracker_name = args.tracker_name;
   overlap_thresh = args.overlap_thresh;
   center_error_thresh = args.center_error_thresh;
+  deadline = args.deadline;
+  cold_start_frames = args.cold_start_frames;
+  realtime = args.realtime;
 }
 
 // Private helper method to calculate the Intersection over Union (IoU) or overlap
@@ -38,17 +49,15 @@ double TrackerPerformanceEvaluator::calculateCenterError(const cv::Rect& ground_
   return cv::norm(gt_center - tr_center);
 }
 
-// Method to add a single frame's results
-ValidationStatus TrackerPerformanceEvaluator::validateAndAddResult(const cv::Rect& ground_truth, const cv::Rect& tracking_result,
-  double processing_time, bool trackerLost)
+// Scores a tracking result against the ground truth, without timing
+ValidationStatus TrackerPerformanceEvaluator::validate(const cv::Rect& ground_truth, const cv::Rect& tracking_result, bool trackerLost,
+  FrameResult& result)
 {
-  FrameResult result;
   ValidationStatus valid_status = !trackerLost ? ValidationStatus::Valid : ValidationStatus::NonValidTrackerLost;
   if (valid_status == ValidationStatus::Valid)
   {
     result.overlap = calculateOverlap(ground_truth, tracking_result);
     result.error = calculateCenterError(ground_truth, tracking_result);
-    result.processing_time = processing_time;
     result.bbox_area = tracking_result.area();
 
     double diagonal = std::sqrt(std::pow(ground_truth.width, 2) + std::pow(ground_truth.height, 2));
@@ -59,10 +68,73 @@ ValidationStatus TrackerPerformanceEvaluator::validateAndAddResult(const cv::Rec
       valid_status = ValidationStatus::NonValidCenterError;
   }
   result.valid = (valid_status == ValidationStatus::Valid);
+  return valid_status;
+}
+
+// Method to add a single frame's results
+ValidationStatus TrackerPerformanceEvaluator::validateAndAddResult(const cv::Rect& ground_truth, const cv::Rect& tracking_result,
+  double processing_time, bool trackerLost)
+{
+  FrameResult result;
+  ValidationStatus valid_status = validate(ground_truth, tracking_result, trackerLost, result);
+  if (!trackerLost)
+  {
+    result.processing_time = processing_time;
+    // without a warm-up the first updates are the cold start, kept out of the steady-state times and deadline misses
+    result.cold_start = !warmed_up && cold_start_times.size() < cold_start_frames;
+    if (result.cold_start)
+    {
+      cold_start_times.push_back(processing_time);
+    }
+    else
+    {
+      latency_histogram.record(processing_time);
+      if (processing_time > deadline)
+        deadline_miss_cnt++;
+    }
+  }
   results.push_back(result);
   return valid_status;
 }
 
+ValidationStatus TrackerPerformanceEvaluator::addSkippedResult(const cv::Rect& ground_truth, const cv::Rect& last_tracking_result,
+  bool trackerLost)
+{
+  FrameResult result;
+  ValidationStatus valid_status = validate(ground_truth, last_tracking_result, trackerLost, result);
+  result.skipped = true;
+  results.push_back(result);
+  skipped_cnt++;
+  return valid_status;
+}
+
+void TrackerPerformanceEvaluator::addStageTimes(const std::vector<std::pair<std::string, double>>& stage_times)
+{
+  if (results.empty() || stage_times.empty())
+    return;
+  if (stage_names.empty())
+  {
+    for (const auto& stage : stage_times)
+      stage_names.push_back(stage.first);
+  }
+  if (stage_times.size() != stage_names.size())
+  {
+    spdlog::warn("Tracker: {} reported {} stages, expected {}", tracker_name, stage_times.size(), stage_names.size());
+    return;
+  }
+
+  auto& stage_results = results.back().stage_times;
+  stage_results.clear();
+  for (const auto& stage : stage_times)
+    stage_results.push_back(stage.second);
+}
+
+void TrackerPerformanceEvaluator::setWarmupTimes(const std::vector<double>& times)
+{
+  cold_start_times.assign(times.begin(), times.begin() + std::min<size_t>(times.size(), cold_start_frames));
+  warmed_up = true;
+}
+
 // Method to calculate and return the average overlap
 double TrackerPerformanceEvaluator::getAverageOverlap() const
 {
@@ -106,7 +178,7 @@ double TrackerPerformanceEvaluator::getAverageProcessingTime() const
 
   for (const auto& result : results)
   {
-    if (result.valid)
+    if (isTimed(result))
     {
       sum_processing_time += result.processing_time;
       valid_count++;
@@ -116,6 +188,27 @@ double TrackerPerformanceEvaluator::getAverageProcessingTime() const
   return valid_count > 0 ? sum_processing_time / valid_count : 0.0;
 }
 
+std::vector<std::pair<std::string, double>> TrackerPerformanceEvaluator::getAverageStageTimes() const
+{
+  std::vector<double> sums(stage_names.size(), 0.0);
+  int valid_count = 0;
+
+  for (const auto& result : results)
+  {
+    if (isTimed(result) && result.stage_times.size() == stage_names.size())
+    {
+      for (size_t i = 0; i < sums.size(); i++)
+        sums[i] += result.stage_times[i];
+      valid_count++;
+    }
+  }
+
+  std::vector<std::pair<std::string, double>> averages;
+  for (size_t i = 0; i < stage_names.size(); i++)
+    averages.emplace_back(stage_names[i], valid_count > 0 ? sums[i] / valid_count : 0.0);
+  return averages;
+}
+
 double TrackerPerformanceEvaluator::getValidFramePercent() const
 {
   int valid_count = 0;
@@ -175,7 +268,7 @@ double TrackerPerformanceEvaluator::getProcessingTimeStd() const
 
   for (const auto& result : results)
   {
-    if (result.valid)
+    if (isTimed(result))
     {
       sum_sq_diff += std::pow(result.processing_time - mean, 2);
       valid_count++;
@@ -195,15 +288,56 @@ void TrackerPerformanceEvaluator::saveResultsToFile(const std::string& filename)
     return;
   }
 
-  file << "Frame,Overlap,Center Error,Processing Time,BBox Area,Valid" << std::endl;
+  file << "Frame,Overlap,Center Error,Processing Time,BBox Area,Valid";
+  for (const auto& stage_name : stage_names)
+    file << "," << stage_name << " Time";
+  file << std::endl;
   for (size_t i = 0; i < results.size(); ++i)
   {
-    file << i + 1 << "," << results[i].overlap << "," << results[i].error << "," << results[i].processing_time << "," << results[i].bbox_area << "," << results[i].valid << "\n";
+    file << i + 1 << "," << results[i].overlap << "," << results[i].error << "," << results[i].processing_time << "," << results[i].bbox_area << "," << results[i].valid;
+    for (size_t j = 0; j < stage_names.size(); j++)
+      file << "," << (j < results[i].stage_times.size() ? results[i].stage_times[j] : -1.0);
+    file << "\n";
   }
 
   file.close();
 }
 
+void TrackerPerformanceEvaluator::saveResultsToColumnarFile(const std::string& filename) const
+{
+  std::vector<double> overlaps, errors, processing_times, bbox_areas;
+  std::vector<uint8_t> valid;
+  std::vector<std::vector<double>> stage_times(stage_names.size());
+  for (const auto& result : results)
+  {
+    overlaps.push_back(result.overlap);
+    errors.push_back(result.error);
+    processing_times.push_back(result.processing_time);
+    bbox_areas.push_back(result.bbox_area);
+    valid.push_back(result.valid);
+    for (size_t j = 0; j < stage_names.size(); j++)
+      stage_times[j].push_back(j < result.stage_times.size() ? result.stage_times[j] : -1.0);
+  }
+
+  ColumnarResultsWriter writer(results.size());
+  writer.setAttribute("tracker", tracker_name);
+  writer.addColumn("overlap", overlaps);
+  writer.addColumn("error", errors);
+  writer.addColumn("processing_time", processing_times);
+  writer.addColumn("bbox_area", bbox_areas);
+  writer.addColumn("valid", valid);
+  for (size_t j = 0; j < stage_names.size(); j++)
+    writer.addColumn(stage_names[j] + " Time", stage_times[j]);
+  try
+  {
+    writer.save(filename);
+  }
+  catch (const std::exception& e)
+  {
+    spdlog::error("Could not save the results to {}: {}", filename, e.what());
+  }
+}
+
 SequenceTrackingSummary TrackerPerformanceEvaluator::getTrackingSummary()
 {
   SequenceTrackingSummary summary;
@@ -212,9 +346,29 @@ SequenceTrackingSummary TrackerPerformanceEvaluator::getTrackingSummary()
   summary.avg_time = getAverageProcessingTime();
   summary.success_rt = getValidFramePercent();
   summary.reinit_cnt = reinit_cnt;
+  summary.frames = results.size();
+  summary.realtime = realtime;
+  summary.skipped_frames = skipped_cnt;
+  summary.deadline_miss_cnt = deadline_miss_cnt;
+  summary.valid_frames = std::count_if(results.begin(), results.end(), [](const FrameResult& r) { return r.valid; });
+  summary.timed_frames = std::count_if(results.begin(), results.end(), isTimed);
   summary.avg_overlap_std = getOverlapStd();
   summary.avg_cle_std = getErrorStd();
   summary.avg_time_std = getProcessingTimeStd();
+  summary.time_p50 = latency_histogram.getPercentile(50.0);
+  summary.time_p90 = latency_histogram.getPercentile(90.0);
+  summary.time_p99 = latency_histogram.getPercentile(99.0);
+  summary.time_p999 = latency_histogram.getPercentile(99.9);
+  summary.time_max = latency_histogram.getMax();
+  summary.deadline = deadline;
+  summary.deadline_miss_rt = latency_histogram.getCount() > 0 ? deadline_miss_cnt / static_cast<double>(latency_histogram.getCount()) : 0.0;
+  summary.latency_histogram = latency_histogram;
+  summary.avg_stage_times = getAverageStageTimes();
+  summary.cold_start_warmup = warmed_up;
+  summary.cold_start_frames = cold_start_times.size();
+  summary.first_call_time = cold_start_times.empty() ? 0.0 : cold_start_times.front();
+  summary.first_n_time = cold_start_times.empty() ? 0.0
+    : std::accumulate(cold_start_times.begin(), cold_start_times.end(), 0.0) / cold_start_times.size();
 
   spdlog::info("Tracker: {} statistics:\n"
     "Average Overlap: {}\n"
@@ -224,7 +378,11 @@ SequenceTrackingSummary TrackerPerformanceEvaluator::getTrackingSummary()
     "Reinit number: {}\n"
     "Overlap Std Dev: {}\n"
     "Error Std Dev: {}\n"
-    "Processing Time Std Dev: {}",
+    "Processing Time Std Dev: {}\n"
+    "Processing Time p50/p90/p99/p99.9/max: {}/{}/{}/{}/{}\n"
+    "Deadline Miss Rate: {}\n"
+    "Skipped Frames: {}\n"
+    "First Call/First {} Processing Time: {}/{}",
     tracker_name,
     summary.avg_overlap,
     summary.avg_cle,
@@ -233,7 +391,17 @@ SequenceTrackingSummary TrackerPerformanceEvaluator::getTrackingSummary()
     summary.reinit_cnt,
     summary.avg_overlap_std,
     summary.avg_cle_std,
-    summary.avg_time_std);
+    summary.avg_time_std,
+    summary.time_p50,
+    summary.time_p90,
+    summary.time_p99,
+    summary.time_p999,
+    summary.time_max,
+    summary.deadline_miss_rt,
+    summary.skipped_frames,
+    summary.cold_start_frames,
+    summary.first_call_time,
+    summary.first_n_time);
 
   return summary;
 }
\ No newline at end of file
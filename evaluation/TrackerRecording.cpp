@@ -0,0 +1,101 @@
+#include "TrackerRecording.hpp"
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+
+const char* const record_columns = "Frame,GT X,GT Y,GT Width,GT Height,Occluded,Updated,X,Y,Width,Height,Score,State,Processing Time,Reinited";
+const size_t record_columns_num = 15;
+const std::string stage_suffix = " Time";
+
+std::vector<std::string> splitFields(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ','))
+        fields.push_back(field);
+    return fields;
+}
+
+}
+
+void TrackerRecording::saveToFile(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Could not open the file: " + filename);
+
+    // times and scores are written exactly, the replay has to reach the same decisions
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << record_columns;
+    for (const auto& stage_name : stage_names)
+        file << "," << stage_name << stage_suffix;
+    file << "\n";
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        const RecordedFrame& frame = frames[i];
+        file << i + 1 << "," << frame.ground_truth.x << "," << frame.ground_truth.y << "," << frame.ground_truth.width << ","
+            << frame.ground_truth.height << "," << frame.occluded << "," << frame.updated << "," << frame.bbox.x << ","
+            << frame.bbox.y << "," << frame.bbox.width << "," << frame.bbox.height << "," << frame.score << "," << frame.state
+            << "," << frame.processing_time << "," << frame.reinited;
+        for (size_t j = 0; j < stage_names.size(); j++)
+            file << "," << (j < frame.stage_times.size() ? frame.stage_times[j] : -1.0);
+        file << "\n";
+    }
+}
+
+TrackerRecording TrackerRecording::loadFromFile(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Could not open the file: " + filename);
+
+    TrackerRecording recording;
+    std::string line;
+    if (!std::getline(file, line) || line.compare(0, std::string(record_columns).size(), record_columns) != 0)
+        throw std::runtime_error(filename + ": not a tracker recording");
+    std::vector<std::string> header = splitFields(line);
+    for (size_t i = record_columns_num; i < header.size(); i++)
+    {
+        std::string name = header[i];
+        if (name.size() > stage_suffix.size() && name.compare(name.size() - stage_suffix.size(), stage_suffix.size(), stage_suffix) == 0)
+            name.resize(name.size() - stage_suffix.size());
+        recording.stage_names.push_back(name);
+    }
+
+    size_t line_number = 1;
+    while (std::getline(file, line))
+    {
+        line_number++;
+        if (line.empty())
+            continue;
+        std::vector<std::string> fields = splitFields(line);
+        if (fields.size() != header.size())
+            throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": expected " + std::to_string(header.size()) + " fields");
+        try
+        {
+            RecordedFrame frame;
+            frame.ground_truth = cv::Rect(std::stoi(fields[1]), std::stoi(fields[2]), std::stoi(fields[3]), std::stoi(fields[4]));
+            frame.occluded = std::stoi(fields[5]);
+            frame.updated = std::stoi(fields[6]) != 0;
+            frame.bbox = cv::Rect(std::stoi(fields[7]), std::stoi(fields[8]), std::stoi(fields[9]), std::stoi(fields[10]));
+            frame.score = std::stod(fields[11]);
+            frame.state = fields[12];
+            frame.processing_time = std::stod(fields[13]);
+            frame.reinited = std::stoi(fields[14]) != 0;
+            for (size_t i = record_columns_num; i < fields.size(); i++)
+                frame.stage_times.push_back(std::stod(fields[i]));
+            recording.frames.push_back(std::move(frame));
+        }
+        catch (const std::logic_error&)
+        {
+            throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": malformed number");
+        }
+    }
+    return recording;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+// Binary per-frame results, one contiguous typed array per column.
+// Layout: "TCRESULT", uint32 version, uint32 data offset, then a JSON header describing the rows and the columns
+// (name, NumPy dtype, byte offset), padded with spaces up to the data offset. Columns are little endian and start
+// at 64 byte aligned offsets, so each one can be used in place from a memory mapping, eg. with numpy.memmap.
+struct ColumnarResultsColumn
+{
+    std::string name;
+    std::string dtype; // NumPy type string, eg. "<f8"
+    std::vector<char> bytes;
+};
+
+template <typename T>
+const char* columnDtype();
+template <> inline const char* columnDtype<double>() { return "<f8"; }
+template <> inline const char* columnDtype<float>() { return "<f4"; }
+template <> inline const char* columnDtype<int32_t>() { return "<i4"; }
+template <> inline const char* columnDtype<uint32_t>() { return "<u4"; }
+template <> inline const char* columnDtype<uint8_t>() { return "|u1"; }
+
+class ColumnarResultsWriter
+{
+public:
+    explicit ColumnarResultsWriter(size_t rows) : rows(rows) {}
+
+    template <typename T>
+    void addColumn(const std::string& name, const std::vector<T>& values)
+    {
+        if (values.size() != rows)
+            throw std::invalid_argument("Column " + name + " has " + std::to_string(values.size()) + " rows, expected " + std::to_string(rows));
+        ColumnarResultsColumn column{ name, columnDtype<T>(), {} };
+        column.bytes.assign(reinterpret_cast<const char*>(values.data()), reinterpret_cast<const char*>(values.data() + values.size()));
+        columns.push_back(std::move(column));
+    }
+
+    // Extra header entry, eg. the tracker name
+    void setAttribute(const std::string& key, const std::string& value);
+
+    // Written to a temporary file and renamed, throws std::runtime_error when it fails
+    void save(const std::string& filename) const;
+
+private:
+    size_t rows;
+    std::vector<ColumnarResultsColumn> columns;
+    std::vector<std::pair<std::string, std::string>> attributes;
+};
+
+// Memory mapped results file, columns are read in place
+class ColumnarResultsReader
+{
+public:
+    // Throws std::runtime_error when the file is missing or malformed
+    explicit ColumnarResultsReader(const std::string& filename);
+    ~ColumnarResultsReader();
+
+    size_t getRows() const { return rows; }
+    std::vector<std::string> getColumnNames() const;
+    std::string getAttribute(const std::string& key) const;
+    bool hasColumn(const std::string& name) const;
+
+    // Values of a column, valid as long as the reader, throws when the column is missing or has another type
+    template <typename T>
+    const T* getColumn(const std::string& name) const
+    {
+        return static_cast<const T*>(getColumnData(name, columnDtype<T>()));
+    }
+
+private:
+    struct Column
+    {
+        std::string name;
+        std::string dtype;
+        uint64_t offset;
+    };
+
+    const void* getColumnData(const std::string& name, const std::string& dtype) const;
+
+    std::unique_ptr<MappedFile> file;
+    size_t rows = 0;
+    std::vector<Column> columns;
+    std::vector<std::pair<std::string, std::string>> attributes;
+};
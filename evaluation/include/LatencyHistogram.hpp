@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+// Log-linear histogram of latencies with microsecond resolution (HDR histogram layout).
+// Every power of two range is split into linear sub-buckets, so the relative error stays
+// below 2^-(precision_bits - 1) over the whole range while the storage stays small.
+// Histograms with equal precision can be merged without any loss.
+class LatencyHistogram
+{
+public:
+    explicit LatencyHistogram(unsigned precision_bits = 8);
+
+    void record(double seconds);
+    void merge(const LatencyHistogram& other);
+
+    uint64_t getCount() const;
+    // p in [0, 100], returns the highest latency equivalent to the bucket holding the percentile, in seconds
+    double getPercentile(double p) const;
+    double getMax() const;
+    // Fraction of recorded latencies which are above the given one, exact up to the bucket resolution
+    double getFractionAbove(double seconds) const;
+
+    unsigned getPrecisionBits() const { return precision_bits; }
+    const std::vector<uint64_t>& getCounts() const { return counts; }
+    // Restores a histogram saved with operator<<
+    static LatencyHistogram fromYAML(const YAML::Node& node);
+
+private:
+    size_t bucketIndex(uint64_t value_us) const;
+    uint64_t bucketLowerBound(size_t index) const;
+    uint64_t bucketUpperBound(size_t index) const;
+
+    unsigned precision_bits;
+    uint64_t sub_bucket_count;
+    std::vector<uint64_t> counts;
+    uint64_t total_count = 0;
+    uint64_t max_us = 0;
+};
+
+// Sparse form: precision and the list of non empty [bucket, count] pairs
+YAML::Emitter& operator<<(YAML::Emitter& out, const LatencyHistogram& histogram);
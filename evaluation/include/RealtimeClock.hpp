@@ -0,0 +1,16 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+
+// Virtual time of a tracker in real-time mode, frames arrive every frame_interval seconds
+struct RealtimeClock
+{
+    double free_at = 0;      // when the tracker finishes its current update, in seconds from the first frame
+    unsigned last_frame = 0; // last frame the tracker was given
+    cv::Rect last_bbox;      // last output, scored on the frames arriving while the tracker is busy
+
+    // A tracker which becomes free takes the newest frame which has already arrived, or waits for the next one
+    bool isFrameDue(unsigned frame, double frame_interval) const;
+    // The update starts once both the tracker and the frame are there, frames arriving meanwhile are skipped
+    void update(unsigned frame, double frame_interval, double processing_time, const cv::Rect& bbox);
+};
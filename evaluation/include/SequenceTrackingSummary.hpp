@@ -1,6 +1,9 @@
 #pragma once
 
+#include <string>
+#include <vector>
 #include <yaml-cpp/yaml.h>
+#include "LatencyHistogram.hpp"
 
 struct SequenceTrackingSummary
 {
@@ -10,8 +13,32 @@ struct SequenceTrackingSummary
     double avg_cle_std;
     double avg_time; 
     double avg_time_std; 
+    double time_p50;
+    double time_p90;
+    double time_p99;
+    double time_p999;
+    double time_max;
+    double deadline;
+    double deadline_miss_rt; // fraction of frames processed slower than the deadline
+    unsigned int deadline_miss_cnt = 0;
+    // real-time simulation, frames which arrived while the tracker was busy are scored with its last output
+    bool realtime = false;
+    size_t skipped_frames = 0;
     double success_rt;
     unsigned int reinit_cnt;
+    size_t frames = 0;       // evaluated frames, success_rt is valid_frames / frames
+    size_t valid_frames = 0; // frames the averages and std devs are computed over
+    size_t timed_frames = 0; // valid frames the tracker was run on outside the cold start, the time and stage time averages are computed over
+    LatencyHistogram latency_histogram;
+    std::vector<std::pair<std::string, double>> avg_stage_times; // empty if the tracker is not instrumented
+    // cold start, either from the warm-up run or from the first timed frames
+    bool cold_start_warmup = false;
+    size_t cold_start_frames = 0;
+    double first_call_time = 0;
+    double first_n_time = 0; // average of the first cold_start_frames updates
 };
 
 YAML::Emitter& operator<<(YAML::Emitter& out, const SequenceTrackingSummary& summary);
+// Restores a summary saved with operator<<, frames and valid_frames stay 0 in summaries written without them,
+// timed_frames defaults to valid_frames as nothing was skipped before it was written
+SequenceTrackingSummary summaryFromYAML(const YAML::Node& node);
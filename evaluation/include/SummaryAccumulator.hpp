@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include "SequenceTrackingSummary.hpp"
+
+// Merges summaries of many sequences into one as if all their frames were evaluated as a single sequence.
+// Means and std devs are pooled over the valid frames (time ones over the valid frames which were not skipped), rates are weighted by the frames they were computed over
+// and latency percentiles come from the merged histograms, so no average of averages is taken.
+class SummaryAccumulator
+{
+public:
+    // The summary has to carry its frame counts
+    void add(const SequenceTrackingSummary& summary);
+    void merge(const SummaryAccumulator& other);
+
+    SequenceTrackingSummary getSummary() const;
+    size_t getSequenceCount() const { return sequences; }
+
+private:
+    // Count, mean and sum of squared differences from the mean, merged with the parallel variance formula
+    struct Moments
+    {
+        uint64_t count = 0;
+        double mean = 0;
+        double m2 = 0;
+
+        void merge(const Moments& other);
+        double getStd() const; // sample std dev, as in TrackerPerformanceEvaluator
+    };
+    static Moments fromSummary(uint64_t count, double mean, double std);
+
+    size_t sequences = 0;
+    uint64_t frames = 0;
+    uint64_t valid_frames = 0;
+    uint64_t timed_frames = 0;
+    uint64_t reinit_cnt = 0;
+    uint64_t deadline_misses = 0;
+    uint64_t skipped_frames = 0;
+    bool realtime = false;
+    double deadline = 0;
+    Moments overlap;
+    Moments error;
+    Moments time;
+    std::map<std::string, double> stage_time_sums; // weighted by timed frames
+    std::vector<std::string> stage_names;
+    LatencyHistogram latency_histogram;
+};
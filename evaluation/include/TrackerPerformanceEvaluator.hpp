@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include "SequenceTrackingSummary.hpp"
+#include "LatencyHistogram.hpp"
 
 struct FrameResult
 {
@@ -13,6 +14,9 @@ struct FrameResult
     double processing_time = -1.0; // processing times for each frame in seconds
     double bbox_area = -1.0;       // area of the bounding box in pixels
     bool valid = false;             // whether the tracking result is valid or not
+    bool skipped = false;           // real-time mode, the tracker was busy and is scored with its last output
+    bool cold_start = false;        // one of the first updates without a warm-up, only in the cold start times
+    std::vector<double> stage_times; // optional per stage processing times in seconds, empty if not provided
 };
 
 enum class ValidationStatus
@@ -30,6 +34,9 @@ struct TrackerPerformanceEvaluatorArgs
     std::string tracker_name;
     double overlap_thresh = 0.3;
     double center_error_thresh = 0.3;
+    double deadline = 1.0 / 30; // per frame processing time budget in seconds
+    unsigned cold_start_frames = 5; // number of first update times reported apart as cold start
+    bool realtime = false; // frames can be skipped, the deadline is the frame interval of the source
 };
 
 class TrackerPerformanceEvaluator
@@ -37,6 +44,13 @@ class TrackerPerformanceEvaluator
 public:
     TrackerPerformanceEvaluator(const TrackerPerformanceEvaluatorArgs& args);
     ValidationStatus validateAndAddResult(const cv::Rect& ground_truth, const cv::Rect& tracking_result, double processing_time, bool prior_valid);
+    // Real-time mode, a frame which arrived while the tracker was busy, scored with its last output and not timed
+    ValidationStatus addSkippedResult(const cv::Rect& ground_truth, const cv::Rect& last_tracking_result, bool trackerLost);
+    // Attaches the stage breakdown of the processing time to the last added result
+    void addStageTimes(const std::vector<std::pair<std::string, double>>& stage_times);
+    // Update times of an untimed warm-up run, reported as cold start instead of the first timed frames
+    void setWarmupTimes(const std::vector<double>& times);
+    const std::vector<double>& getWarmupTimes() const { return cold_start_times; }
 
     double getAverageOverlap() const;
     double getAverageError() const;
@@ -45,8 +59,11 @@ public:
     double getOverlapStd() const;
     double getErrorStd() const;
     double getProcessingTimeStd() const;
+    std::vector<std::pair<std::string, double>> getAverageStageTimes() const;
 
     void saveResultsToFile(const std::string& filename) const;
+    // Same columns in the binary columnar format (ColumnarResults.hpp), stage times as "<stage> Time"
+    void saveResultsToColumnarFile(const std::string& filename) const;
 
     SequenceTrackingSummary getTrackingSummary();
 
@@ -61,14 +78,26 @@ public:
     }
 
 private:
+    ValidationStatus validate(const cv::Rect& ground_truth, const cv::Rect& tracking_result, bool trackerLost, FrameResult& result);
     double calculateOverlap(const cv::Rect& ground_truth, const cv::Rect& tracking_result);
     double calculateCenterError(const cv::Rect& ground_truth, const cv::Rect& tracking_result);
 
     std::vector<FrameResult> results;
+    std::vector<std::string> stage_names;
     std::string tracker_name;
     // params loaded from config
     double overlap_thresh = 0.3;
     double center_error_thresh = 0.3; // normalized diagonal of the bounding box
+    double deadline = 1.0 / 30;
+
+    // latencies of all frames the tracker was updated on, valid or not
+    LatencyHistogram latency_histogram;
+    unsigned int deadline_miss_cnt = 0;
+    bool realtime = false;
+    size_t skipped_cnt = 0;
+    unsigned cold_start_frames = 5;
+    std::vector<double> cold_start_times;
+    bool warmed_up = false; // cold start times come from the warm-up, not from the timed frames
     
     unsigned int reinit_cnt = 0;
 };
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+// Raw output of a tracker on one evaluated frame, enough to evaluate it again without running the tracker
+struct RecordedFrame
+{
+    cv::Rect ground_truth;
+    int occluded = -1;
+    bool updated = false;          // false while the tracker is lost, bbox and score are then meaningless
+    cv::Rect bbox;
+    double score = -1;
+    std::string state;             // tracker state after the update
+    double processing_time = 0;    // in seconds
+    std::vector<double> stage_times;
+    bool reinited = false;         // tracker was reinitialized on the ground truth after this frame
+};
+
+// Everything a tracker produced on a sequence, saved as <tracker>_record.csv next to the results
+struct TrackerRecording
+{
+    std::string tracker_name;
+    std::vector<std::string> stage_names;
+    std::vector<double> warmup_times; // empty when the trackers were warmed up on an earlier sequence
+    std::vector<RecordedFrame> frames;
+
+    void saveToFile(const std::string& filename) const;
+    // Loads frames and stage names, throws std::runtime_error on a malformed file
+    static TrackerRecording loadFromFile(const std::string& filename);
+};
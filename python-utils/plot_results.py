@@ -1,7 +1,7 @@
 import os
-import csv
 import argparse
 import matplotlib.pyplot as plt
+from results_io import find_results_files, load_results
 
 
 def process_tracker_results_from_directory(directory, frame_limit=None):
@@ -15,40 +15,17 @@ def process_tracker_results_from_directory(directory, frame_limit=None):
 
     tracker_data = {}
 
-    # Iterate over all files in the directory
-    for filename in os.listdir(directory):
-        if filename.endswith("results.csv"):
-            filepath = os.path.join(directory, filename)
-            tracker_name = os.path.splitext(filename)[0]
-
-            frame_numbers = []
-            overlaps = []
-            errors = []
-            processing_times = []
-            bbox_areas = []
-            valid_indicators = []
-
-            with open(filepath, 'r') as file:
-                reader = csv.DictReader(file)
-                for row in reader:
-                    if not row['Frame'].isdigit():
-                        continue
-
-                    frame_numbers.append(int(row['Frame']))
-                    overlaps.append(float(row['Overlap']))
-                    errors.append(float(row['Center Error']))
-                    processing_times.append(float(row['Processing Time']))
-                    bbox_areas.append(float(row['BBox Area']))
-                    valid_indicators.append(float(row['Valid']))
-
-            tracker_data[tracker_name] = {
-                'frames': frame_numbers,
-                'overlaps': overlaps,
-                'errors': errors,
-                'processing_times': processing_times,
-                'bbox_areas': bbox_areas,
-                'valid_indicators': valid_indicators
-            }
+    # Iterate over all results files in the directory, columnar ones are memory mapped
+    for tracker_name, filepath in find_results_files(directory).items():
+        columns = load_results(filepath)
+        tracker_data[tracker_name] = {
+            'frames': columns['frame'].tolist(),
+            'overlaps': columns['overlap'].tolist(),
+            'errors': columns['error'].tolist(),
+            'processing_times': columns['processing_time'].tolist(),
+            'bbox_areas': columns['bbox_area'].tolist(),
+            'valid_indicators': columns['valid'].astype(float).tolist()
+        }
 
        # Determine the maximum frame number to plot
     if frame_limit is not None:
@@ -0,0 +1,140 @@
+import os
+import argparse
+import random
+import cv2
+import numpy as np
+from onnxruntime.quantization import CalibrationDataReader, QuantFormat, QuantType, quantize_static
+
+TEMPLATE_SIZE = 128
+SEARCH_SIZE = 256
+MEAN = np.array([0.485, 0.456, 0.406], dtype=np.float32)
+STD = np.array([0.229, 0.224, 0.225], dtype=np.float32)
+
+
+def load_custom_annotations(path, width, height):
+    # frame, center x, center y, width, height (normalized), occluded
+    annotations = {}
+    with open(path) as f:
+        for line in f:
+            values = line.strip().split(',')
+            if len(values) < 5:
+                continue
+            cx, cy, w, h = (float(v) for v in values[1:5])
+            annotations[int(values[0])] = ((cx - w / 2) * width, (cy - h / 2) * height, w * width, h * height)
+    return annotations
+
+
+def load_otb_annotations(path):
+    annotations = {}
+    with open(path) as f:
+        for frame, line in enumerate(f):
+            values = line.replace(',', ' ').split()
+            if len(values) >= 4:
+                annotations[frame] = tuple(float(v) for v in values[:4])
+    return annotations
+
+
+def read_sequence(sequence_path):
+    # yields (frame, bbox) pairs of annotated frames, in the same layouts tracker_compare accepts
+    files = os.listdir(sequence_path)
+    videos = [f for f in files if f.endswith('.mp4')]
+    gt_files = [f for f in files if f.endswith('.txt')]
+    if not gt_files:
+        return
+    gt_path = os.path.join(sequence_path, gt_files[0])
+
+    if videos:
+        cap = cv2.VideoCapture(os.path.join(sequence_path, videos[0]))
+        width = int(cap.get(cv2.CAP_PROP_FRAME_WIDTH))
+        height = int(cap.get(cv2.CAP_PROP_FRAME_HEIGHT))
+        annotations = load_custom_annotations(gt_path, width, height)
+        frame_num = 0
+        while True:
+            ok, frame = cap.read()
+            if not ok:
+                break
+            if frame_num in annotations:
+                yield frame, annotations[frame_num]
+            frame_num += 1
+        cap.release()
+    elif 'img' in files:
+        annotations = load_otb_annotations(gt_path)
+        images = sorted(os.listdir(os.path.join(sequence_path, 'img')))
+        for frame_num, image in enumerate(images):
+            if frame_num in annotations:
+                yield cv2.imread(os.path.join(sequence_path, 'img', image)), annotations[frame_num]
+
+
+def crop_patch(image, bbox, factor, size):
+    # same square crop around the target as the tracker (cropResizedPatch), padded with zeros
+    x, y, w, h = (int(v) for v in bbox)
+    crop_size = int(np.ceil(np.sqrt(w * h) * factor))
+    x1 = x + (w - crop_size) // 2
+    y1 = y + (h - crop_size) // 2
+    s = crop_size / size
+    dst_to_src = np.array([[s, 0, x1 + 0.5 * s - 0.5], [0, s, y1 + 0.5 * s - 0.5]], dtype=np.float64)
+    return cv2.warpAffine(image, dst_to_src, (size, size), flags=cv2.INTER_LINEAR | cv2.WARP_INVERSE_MAP,
+                          borderMode=cv2.BORDER_CONSTANT)
+
+
+def to_blob(patch):
+    # channels stay in BGR order, as in the tracker
+    normalized = (patch.astype(np.float32) / 255.0 - MEAN) / STD
+    return normalized.transpose(2, 0, 1)[np.newaxis]
+
+
+def collect_samples(dataset_path, samples_num, seed):
+    # template from the first annotated frame of a sequence, search patches from later frames
+    # with a jittered center, like the tracker sees them after motion
+    rng = random.Random(seed)
+    sequences = sorted(os.path.join(dataset_path, d) for d in os.listdir(dataset_path)
+                       if os.path.isdir(os.path.join(dataset_path, d)))
+    if not sequences:
+        sequences = [dataset_path]
+    per_sequence = max(1, samples_num // len(sequences))
+
+    samples = []
+    for sequence in sequences:
+        frames = [(f, b) for f, b in read_sequence(sequence) if b[2] > 0 and b[3] > 0]
+        if not frames:
+            continue
+        template = to_blob(crop_patch(frames[0][0], frames[0][1], 2, TEMPLATE_SIZE))
+        for frame, (x, y, w, h) in rng.sample(frames, min(per_sequence, len(frames))):
+            jittered = (x + rng.uniform(-0.5, 0.5) * w, y + rng.uniform(-0.5, 0.5) * h, w, h)
+            samples.append({"template": template, "search": to_blob(crop_patch(frame, jittered, 4, SEARCH_SIZE))})
+        print(f"Calibration samples from {sequence}: {len(samples)} total")
+    return samples
+
+
+class DatasetCalibrationReader(CalibrationDataReader):
+    def __init__(self, samples):
+        self.iterator = iter(samples)
+
+    def get_next(self):
+        return next(self.iterator, None)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build an INT8 VIT tracker model calibrated on dataset frames")
+    parser.add_argument("model", help="Path to the fp32 onnx model")
+    parser.add_argument("dataset", help="Path to the dataset, same layout as for tracker_compare")
+    parser.add_argument("--output", default="nn_models/vit_int8.onnx")
+    parser.add_argument("--samples", type=int, default=200, help="Number of calibration samples")
+    parser.add_argument("--per_channel", action="store_true", help="Per channel weight quantization")
+    parser.add_argument("--seed", type=int, default=0)
+    args = parser.parse_args()
+
+    samples = collect_samples(args.dataset, args.samples, args.seed)
+    if not samples:
+        print(f"Error: no annotated frames found in {args.dataset}")
+        return
+
+    # QDQ keeps the graph readable for the OpenCV dnn onnx importer
+    quantize_static(args.model, args.output, DatasetCalibrationReader(samples),
+                    quant_format=QuantFormat.QDQ, activation_type=QuantType.QInt8, weight_type=QuantType.QInt8,
+                    per_channel=args.per_channel)
+    print(f"Saved quantized model to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
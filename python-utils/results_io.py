@@ -0,0 +1,89 @@
+import os
+import csv
+import json
+import argparse
+import numpy as np
+
+RESULTS_MAGIC = b'TCRESULT'
+CSV_COLUMNS = {'overlap': 'Overlap', 'error': 'Center Error', 'processing_time': 'Processing Time',
+               'bbox_area': 'BBox Area', 'valid': 'Valid'}
+
+
+def load_columnar_results(path):
+    """Memory maps a <tracker>_results.tcr file, returns its header and a dict of column arrays."""
+    with open(path, 'rb') as f:
+        prefix = f.read(16)
+        if prefix[:8] != RESULTS_MAGIC:
+            raise ValueError(f"{path} is not a columnar results file")
+        data_offset = int(np.frombuffer(prefix, dtype='<u4', count=1, offset=12)[0])
+        header = json.loads(f.read(data_offset - 16))
+    rows = header['rows']
+    columns = {}
+    for column in header['columns']:
+        if rows == 0:
+            columns[column['name']] = np.empty(0, dtype=column['dtype'])
+        else:
+            columns[column['name']] = np.memmap(path, dtype=column['dtype'], mode='r', offset=column['offset'], shape=(rows,))
+    return header, columns
+
+
+def load_csv_results(path):
+    """Reads a <tracker>_results.csv file into the same column dict as load_columnar_results."""
+    with open(path, 'r') as f:
+        reader = csv.DictReader(f)
+        rows = [row for row in reader if row['Frame'].isdigit()]
+    columns = {name: np.array([float(row[csv_name]) for row in rows]) for name, csv_name in CSV_COLUMNS.items()}
+    columns['valid'] = columns['valid'].astype(np.uint8)
+    for csv_name in reader.fieldnames or []:
+        if csv_name.endswith(' Time') and csv_name != 'Processing Time':
+            columns[csv_name] = np.array([float(row[csv_name]) for row in rows])
+    return columns
+
+
+def load_results(path):
+    """Columns of a results file in either format, frame numbers start at 1."""
+    if path.endswith('.tcr'):
+        _, columns = load_columnar_results(path)
+    else:
+        columns = load_csv_results(path)
+    columns['frame'] = np.arange(1, len(columns['overlap']) + 1)
+    return columns
+
+
+def find_results_files(directory):
+    """Maps tracker names to their results file, the columnar one when both exist."""
+    files = {}
+    for filename in sorted(os.listdir(directory)):
+        for extension in ('_results.csv', '_results.tcr'):
+            if filename.endswith(extension):
+                tracker_name = filename[:-len(extension)]
+                if tracker_name not in files or extension == '_results.tcr':
+                    files[tracker_name] = os.path.join(directory, filename)
+    return files
+
+
+def export_csv(tcr_path, csv_path):
+    """Writes a columnar results file in the CSV format of the tracker_compare results."""
+    _, columns = load_columnar_results(tcr_path)
+    stage_columns = [name for name in columns if name not in CSV_COLUMNS]
+    with open(csv_path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['Frame'] + list(CSV_COLUMNS.values()) + stage_columns)
+        for i in range(len(columns['overlap'])):
+            row = [i + 1] + [columns[name][i] for name in CSV_COLUMNS] + [columns[name][i] for name in stage_columns]
+            writer.writerow(row)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Export columnar tracker results (.tcr) to CSV.")
+    parser.add_argument('files', nargs='+', help="Columnar results files.")
+    args = parser.parse_args()
+
+    for path in args.files:
+        csv_path = path[:-len('.tcr')] + '.csv' if path.endswith('.tcr') else path + '.csv'
+        export_csv(path, csv_path)
+        print(f"Exported {path} to {csv_path}")
+
+
+if __name__ == "__main__":
+    main()
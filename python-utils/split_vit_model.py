@@ -0,0 +1,52 @@
+import argparse
+import onnx
+import onnx.utils
+
+
+def template_only_tensors(model, template_input):
+    # tensors computed from the template input and weights alone
+    weights = {init.name for init in model.graph.initializer}
+    template_tensors = {template_input}
+    for node in model.graph.node:
+        inputs = [i for i in node.input if i and i not in weights]
+        if inputs and all(i in template_tensors for i in inputs):
+            template_tensors.update(node.output)
+    return template_tensors
+
+
+def find_frontier(model, template_input):
+    # template-only tensors consumed by nodes which also depend on the search input
+    template_tensors = template_only_tensors(model, template_input)
+    frontier = []
+    for node in model.graph.node:
+        if all(o in template_tensors for o in node.output):
+            continue
+        for i in node.input:
+            if i in template_tensors and i != template_input and i not in frontier:
+                frontier.append(i)
+    return frontier
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Split a VIT tracker model into a template encoder and a search net")
+    parser.add_argument("model", help="Path to the full onnx model")
+    parser.add_argument("--template_out", default="nn_models/vit_template.onnx")
+    parser.add_argument("--search_out", default="nn_models/vit_search.onnx")
+    parser.add_argument("--features", nargs="*", help="Template feature tensors to cache, detected when not given")
+    parser.add_argument("--outputs", nargs="*", default=["output1", "output2", "output3"])
+    args = parser.parse_args()
+
+    model = onnx.load(args.model)
+    features = args.features or find_frontier(model, "template")
+    if not features:
+        print("Error: no template-only tensors found, the model can not be split")
+        return
+
+    onnx.utils.extract_model(args.model, args.template_out, ["template"], features)
+    onnx.utils.extract_model(args.model, args.search_out, ["search"] + features, args.outputs)
+    print(f"Template features: {features}")
+    print("Put them in trackers.modvit.template_cache.features in config.yaml")
+
+
+if __name__ == "__main__":
+    main()
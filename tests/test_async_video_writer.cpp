@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "AsyncVideoWriter.hpp"
+
+namespace fs = std::filesystem;
+
+class AsyncVideoWriterTest : public ::testing::Test {
+protected:
+    fs::path testDir;
+    AsyncVideoWriterArgs args;
+
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "test_async_video_writer";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir);
+        // the built-in MJPEG writer and reader need no codec library
+        args.path = (testDir / "out.avi").string();
+        args.codec = "MJPG";
+        args.queue_size = 2;
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    static int countFrames(const std::string& path, cv::Size& size) {
+        cv::VideoCapture capture(path);
+        int count = 0;
+        cv::Mat frame;
+        while (capture.read(frame)) {
+            size = frame.size();
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(AsyncVideoWriterTest, BlockPolicyWritesEveryFrame) {
+    const int frames = 20;
+    {
+        AsyncVideoWriter writer(args);
+        cv::Mat frame(480, 640, CV_8UC3, cv::Scalar(0, 128, 255));
+        for (int i = 0; i < frames; i++)
+            EXPECT_TRUE(writer.write(frame));
+        writer.finish();
+        VideoWriterStats stats = writer.getStats();
+        EXPECT_EQ(stats.frames_written, frames);
+        EXPECT_EQ(stats.frames_dropped, 0);
+        EXPECT_EQ(stats.frames_resized, 0);
+        EXPECT_FALSE(writer.write(frame)); // finished
+    }
+    cv::Size size;
+    EXPECT_EQ(countFrames(args.path, size), frames);
+    EXPECT_EQ(size, cv::Size(640, 480));
+}
+
+TEST_F(AsyncVideoWriterTest, DropPolicyCountsRejectedFrames) {
+    const int frames = 50;
+    args.full_policy = QueueFullPolicy::Drop;
+    size_t rejected = 0;
+    VideoWriterStats stats;
+    {
+        AsyncVideoWriter writer(args);
+        // queued much faster than full HD frames are encoded, so the two slots fill up
+        cv::Mat frame(1080, 1920, CV_8UC3, cv::Scalar(0, 128, 255));
+        for (int i = 0; i < frames; i++)
+            rejected += writer.write(frame) ? 0 : 1;
+        writer.finish();
+        stats = writer.getStats();
+    }
+    EXPECT_GT(stats.frames_dropped, 0);
+    EXPECT_EQ(stats.frames_dropped, rejected);
+    EXPECT_EQ(stats.frames_written + stats.frames_dropped, frames);
+    cv::Size size;
+    EXPECT_EQ(countFrames(args.path, size), stats.frames_written);
+}
+
+TEST_F(AsyncVideoWriterTest, OutputTakesTheSizeOfTheFirstFrame) {
+    {
+        AsyncVideoWriter writer(args);
+        writer.write(cv::Mat(48, 64, CV_8UC3, cv::Scalar(10, 20, 30)));
+        writer.write(cv::Mat(100, 100, CV_8UC3, cv::Scalar(10, 20, 30)));
+        writer.write(cv::Mat(48, 64, CV_8UC3, cv::Scalar(10, 20, 30)));
+        writer.finish();
+        VideoWriterStats stats = writer.getStats();
+        EXPECT_EQ(stats.frames_written, 3);
+        EXPECT_EQ(stats.frames_resized, 1);
+    }
+    cv::Size size;
+    EXPECT_EQ(countFrames(args.path, size), 3);
+    EXPECT_EQ(size, cv::Size(64, 48));
+}
+
+TEST_F(AsyncVideoWriterTest, ConfiguredSizeResizesOtherFrames) {
+    args.frame_size = cv::Size(32, 32);
+    AsyncVideoWriter writer(args);
+    writer.write(cv::Mat(48, 64, CV_8UC3, cv::Scalar(10, 20, 30)));
+    writer.write(cv::Mat(32, 32, CV_8UC3, cv::Scalar(10, 20, 30)));
+    writer.finish();
+    EXPECT_EQ(writer.getStats().frames_resized, 1);
+}
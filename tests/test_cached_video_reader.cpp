@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "CachedVideoReader.hpp"
+
+namespace fs = std::filesystem;
+
+// Frames filled with their index, counts how many were decoded
+class CountingReader : public VideoReader {
+public:
+    CountingReader(int frames, int& decoded) : frames(frames), decoded(decoded) {}
+
+    bool getNextFrame(cv::Mat& frame) override {
+        if (next >= frames) {
+            done = true;
+            return false;
+        }
+        frame = cv::Mat(4, 6, CV_8UC3, cv::Scalar(next, next, next));
+        next++;
+        decoded++;
+        return true;
+    }
+    bool isDone() const override { return done; }
+    void reset() override { next = 0; done = false; }
+    double getFps() const override { return 25; }
+
+private:
+    int frames;
+    int& decoded;
+    int next = 0;
+    bool done = false;
+};
+
+class CachedVideoReaderTest : public ::testing::Test {
+protected:
+    fs::path testDir;
+    FrameCacheArgs args;
+    int decoded = 0;
+
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "test_frame_cache";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir / "cache");
+        args.directory = (testDir / "cache").string();
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    std::string createMedia(const std::string& name) {
+        fs::path path = testDir / name;
+        std::ofstream(path) << name;
+        return path.string();
+    }
+
+    CachedVideoReader::SourceFactory source(int frames) {
+        return [this, frames]() { return std::make_unique<CountingReader>(frames, decoded); };
+    }
+
+    static int readAll(VideoReader& reader, std::vector<cv::Mat>* frames = nullptr) {
+        int count = 0;
+        cv::Mat frame;
+        while (reader.getNextFrame(frame)) {
+            if (frames)
+                frames->push_back(frame.clone());
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(CachedVideoReaderTest, SecondRunIsServedFromCache) {
+    std::string media = createMedia("video.mp4");
+    {
+        CachedVideoReader reader(media, source(5), args);
+        EXPECT_EQ(readAll(reader), 5);
+        EXPECT_TRUE(reader.getStats().stored);
+    }
+    EXPECT_EQ(decoded, 5);
+
+    CachedVideoReader reader(media, source(5), args);
+    std::vector<cv::Mat> frames;
+    EXPECT_EQ(readAll(reader, &frames), 5);
+    EXPECT_EQ(decoded, 5);
+    EXPECT_TRUE(reader.getStats().hit);
+    EXPECT_DOUBLE_EQ(reader.getFps(), 25);
+    ASSERT_EQ(frames.size(), 5);
+    EXPECT_EQ(frames[3].size(), cv::Size(6, 4));
+    EXPECT_EQ(frames[3].at<cv::Vec3b>(2, 2), cv::Vec3b(3, 3, 3));
+}
+
+TEST_F(CachedVideoReaderTest, PartialReadIsNotCached) {
+    std::string media = createMedia("video.mp4");
+    {
+        CachedVideoReader reader(media, source(5), args);
+        cv::Mat frame;
+        reader.getNextFrame(frame);
+    }
+    CachedVideoReader reader(media, source(5), args);
+    EXPECT_FALSE(reader.getStats().hit);
+    EXPECT_TRUE(fs::is_empty(args.directory) || !fs::exists(fs::path(args.directory) / CachedVideoReader::entryName(media)));
+}
+
+TEST_F(CachedVideoReaderTest, ModifiedMediaIsDecodedAgain) {
+    std::string media = createMedia("video.mp4");
+    {
+        CachedVideoReader reader(media, source(3), args);
+        readAll(reader);
+    }
+    std::ofstream(media, std::ios::app) << "changed";
+    fs::last_write_time(media, fs::last_write_time(media) + std::chrono::seconds(2));
+
+    CachedVideoReader reader(media, source(3), args);
+    EXPECT_FALSE(reader.getStats().hit);
+    readAll(reader);
+    EXPECT_EQ(decoded, 6);
+}
+
+TEST_F(CachedVideoReaderTest, EvictsLeastRecentlyUsed) {
+    std::string first = createMedia("first.mp4");
+    std::string second = createMedia("second.mp4");
+    std::string third = createMedia("third.mp4");
+    {
+        CachedVideoReader reader(first, source(2), args);
+        readAll(reader);
+    }
+    args.max_bytes = 2 * fs::file_size(fs::path(args.directory) / CachedVideoReader::entryName(first));
+    {
+        CachedVideoReader reader(second, source(2), args);
+        readAll(reader);
+    }
+    fs::last_write_time(fs::path(args.directory) / CachedVideoReader::entryName(second),
+        fs::file_time_type::clock::now() + std::chrono::seconds(2));
+    {
+        // first is now the least recently used entry
+        CachedVideoReader reader(third, source(2), args);
+        readAll(reader);
+        EXPECT_EQ(reader.getStats().evicted_entries, 1);
+    }
+    EXPECT_FALSE(fs::exists(fs::path(args.directory) / CachedVideoReader::entryName(first)));
+    EXPECT_TRUE(fs::exists(fs::path(args.directory) / CachedVideoReader::entryName(second)));
+    EXPECT_TRUE(fs::exists(fs::path(args.directory) / CachedVideoReader::entryName(third)));
+}
+
+TEST_F(CachedVideoReaderTest, SequenceLargerThanCacheIsNotStored) {
+    std::string media = createMedia("video.mp4");
+    args.max_bytes = 256;
+    {
+        CachedVideoReader reader(media, source(10), args);
+        EXPECT_EQ(readAll(reader), 10);
+        EXPECT_FALSE(reader.getStats().stored);
+    }
+    EXPECT_TRUE(fs::is_empty(args.directory));
+}
+
+TEST_F(CachedVideoReaderTest, EntryTruncatedInFramePaddingIsDecodedAgain) {
+    std::string media = createMedia("video.mp4");
+    {
+        CachedVideoReader reader(media, source(3), args);
+        readAll(reader);
+    }
+    // 64 byte file header, every 4x6x3 frame is a 64 byte header and 72 bytes of data padded to 128,
+    // the cut lands in the padding of the second frame so the third frame starts past the end of the file
+    fs::path entry = fs::path(args.directory) / CachedVideoReader::entryName(media);
+    ASSERT_EQ(fs::file_size(entry), 64 + 3 * (64 + 128));
+    fs::resize_file(entry, 64 + (64 + 128) + 64 + 100);
+
+    CachedVideoReader reader(media, source(3), args);
+    EXPECT_FALSE(reader.getStats().hit);
+    EXPECT_EQ(readAll(reader), 3);
+    EXPECT_EQ(decoded, 6);
+}
+
+TEST_F(CachedVideoReaderTest, EntryWithInconsistentFrameHeaderIsDecodedAgain) {
+    std::string media = createMedia("video.mp4");
+    {
+        CachedVideoReader reader(media, source(2), args);
+        readAll(reader);
+    }
+    // more rows than the stored bytes hold
+    fs::path entry = fs::path(args.directory) / CachedVideoReader::entryName(media);
+    {
+        std::fstream file(entry, std::ios::in | std::ios::out | std::ios::binary);
+        int32_t rows = 400;
+        file.seekp(64);
+        file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    }
+
+    CachedVideoReader reader(media, source(2), args);
+    EXPECT_FALSE(reader.getStats().hit);
+    EXPECT_EQ(readAll(reader), 2);
+    EXPECT_EQ(decoded, 4);
+}
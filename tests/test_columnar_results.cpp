@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "ColumnarResults.hpp"
+
+namespace fs = std::filesystem;
+
+class ColumnarResultsTest : public ::testing::Test {
+protected:
+    fs::path filename;
+
+    void SetUp() override {
+        filename = fs::temp_directory_path() / "test_results.tcr";
+    }
+
+    void TearDown() override {
+        fs::remove(filename);
+    }
+};
+
+TEST_F(ColumnarResultsTest, ColumnsAreReadInPlace) {
+    std::vector<double> overlaps = { 0.5, 0.75, -1.0 };
+    std::vector<uint8_t> valid = { 1, 1, 0 };
+    ColumnarResultsWriter writer(3);
+    writer.setAttribute("tracker", "Mod\"VIT");
+    writer.addColumn("overlap", overlaps);
+    writer.addColumn("valid", valid);
+    writer.save(filename.string());
+
+    ColumnarResultsReader reader(filename.string());
+    EXPECT_EQ(reader.getRows(), 3);
+    EXPECT_EQ(reader.getColumnNames(), std::vector<std::string>({ "overlap", "valid" }));
+    EXPECT_EQ(reader.getAttribute("tracker"), "Mod\"VIT");
+    const double* read_overlaps = reader.getColumn<double>("overlap");
+    const uint8_t* read_valid = reader.getColumn<uint8_t>("valid");
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(read_overlaps) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(read_valid) % 64, 0);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(read_overlaps[i], overlaps[i]);
+        EXPECT_EQ(read_valid[i], valid[i]);
+    }
+}
+
+TEST_F(ColumnarResultsTest, WrongTypeOrMissingColumnThrows) {
+    ColumnarResultsWriter writer(1);
+    writer.addColumn("overlap", std::vector<double>{ 0.5 });
+    writer.save(filename.string());
+
+    ColumnarResultsReader reader(filename.string());
+    EXPECT_FALSE(reader.hasColumn("error"));
+    EXPECT_THROW(reader.getColumn<float>("overlap"), std::runtime_error);
+    EXPECT_THROW(reader.getColumn<double>("error"), std::runtime_error);
+}
+
+TEST_F(ColumnarResultsTest, EmptyResults) {
+    ColumnarResultsWriter writer(0);
+    writer.addColumn("overlap", std::vector<double>());
+    writer.save(filename.string());
+
+    ColumnarResultsReader reader(filename.string());
+    EXPECT_EQ(reader.getRows(), 0);
+}
+
+TEST_F(ColumnarResultsTest, TruncatedFileIsRejected) {
+    ColumnarResultsWriter writer(100);
+    writer.addColumn("overlap", std::vector<double>(100, 0.5));
+    writer.save(filename.string());
+    fs::resize_file(filename, fs::file_size(filename) - 64);
+
+    EXPECT_THROW(ColumnarResultsReader reader(filename.string()), std::runtime_error);
+}
+
+TEST_F(ColumnarResultsTest, RowCountMismatchIsRejected) {
+    ColumnarResultsWriter writer(2);
+    EXPECT_THROW(writer.addColumn("overlap", std::vector<double>{ 0.5 }), std::invalid_argument);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "DatasetIndex.hpp"
+
+namespace fs = std::filesystem;
+
+class DatasetIndexTest : public ::testing::Test {
+protected:
+    fs::path testDir;
+    fs::path indexPath;
+
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "test_dataset_index";
+        indexPath = fs::temp_directory_path() / "test_dataset_index.bin";
+        fs::remove_all(testDir);
+        fs::remove(indexPath);
+        fs::create_directory(testDir);
+
+        createSequence("instance1", "1,0.1,0.2,0.3,0.4,0\n2,0.2,0.3,0.3,0.4,1\n");
+        createSequence("instance2", "1,0.5,0.5,0.1,0.1,0\n");
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+        fs::remove(indexPath);
+    }
+
+    void createSequence(const std::string& name, const std::string& annotations) {
+        fs::create_directory(testDir / name);
+        std::ofstream(testDir / name / "video.mp4").close();
+        std::ofstream(testDir / name / "truth.txt") << annotations;
+    }
+
+    // modification times have a coarse resolution on some filesystems
+    void touchLater(const fs::path& path) {
+        fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(2));
+    }
+};
+
+TEST_F(DatasetIndexTest, MatchesLoadDatasetInfos) {
+    DatasetIndex index(testDir.string(), indexPath.string());
+    auto indexed = index.getDatasetInfos();
+    auto loaded = loadDatasetInfos(testDir.string());
+
+    ASSERT_EQ(indexed.size(), loaded.size());
+    for (const auto& info : loaded) {
+        auto it = std::find_if(indexed.begin(), indexed.end(), [&](const DatasetInfo& d) { return d.name == info.name; });
+        ASSERT_NE(it, indexed.end());
+        EXPECT_EQ(it->media_path, info.media_path);
+        EXPECT_EQ(it->dataset_type, info.dataset_type);
+        EXPECT_EQ(it->annotations.size(), loadCustomAnnotations(info.ground_truth_paths[0]).size());
+    }
+    EXPECT_EQ(index.getRescannedCount(), 2);
+}
+
+TEST_F(DatasetIndexTest, ReusesSavedIndex) {
+    DatasetIndex(testDir.string(), indexPath.string());
+    ASSERT_TRUE(fs::exists(indexPath));
+
+    DatasetIndex index(testDir.string(), indexPath.string());
+    EXPECT_EQ(index.getRescannedCount(), 0);
+    auto infos = index.getDatasetInfos();
+    ASSERT_EQ(infos.size(), 2);
+    auto it = std::find_if(infos.begin(), infos.end(), [](const DatasetInfo& d) { return d.name == "instance1"; });
+    ASSERT_NE(it, infos.end());
+    auto expected = loadCustomAnnotations(it->ground_truth_paths[0]);
+    ASSERT_EQ(it->annotations.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(it->annotations[i].rect, expected[i].rect);
+        EXPECT_EQ(it->annotations[i].frame, expected[i].frame);
+        EXPECT_EQ(it->annotations[i].occluded, expected[i].occluded);
+    }
+}
+
+TEST_F(DatasetIndexTest, RescansChangedAnnotations) {
+    DatasetIndex(testDir.string(), indexPath.string());
+    fs::path truth = testDir / "instance2" / "truth.txt";
+    std::ofstream(truth, std::ios::app) << "2,0.6,0.5,0.1,0.1,0\n";
+    touchLater(truth);
+
+    DatasetIndex index(testDir.string(), indexPath.string());
+    EXPECT_EQ(index.getRescannedCount(), 1);
+    auto infos = index.getDatasetInfos();
+    auto it = std::find_if(infos.begin(), infos.end(), [](const DatasetInfo& d) { return d.name == "instance2"; });
+    ASSERT_NE(it, infos.end());
+    EXPECT_EQ(it->annotations.size(), 2);
+}
+
+TEST_F(DatasetIndexTest, DetectsNewSequence) {
+    DatasetIndex(testDir.string(), indexPath.string());
+    createSequence("instance3", "1,0.5,0.5,0.1,0.1,0\n");
+    touchLater(testDir);
+
+    DatasetIndex index(testDir.string(), indexPath.string());
+    EXPECT_EQ(index.getRescannedCount(), 1);
+    EXPECT_EQ(index.getDatasetInfos().size(), 3);
+}
+
+TEST_F(DatasetIndexTest, RebuildsCorruptedIndex) {
+    DatasetIndex(testDir.string(), indexPath.string());
+    auto size = fs::file_size(indexPath);
+    fs::resize_file(indexPath, size / 2);
+
+    DatasetIndex index(testDir.string(), indexPath.string());
+    EXPECT_EQ(index.getRescannedCount(), 2);
+    EXPECT_EQ(index.getDatasetInfos().size(), 2);
+}
+
+TEST_F(DatasetIndexTest, FirstAnnotationFileIsTheSameWithAndWithoutIndex) {
+    std::ofstream(testDir / "instance1" / "a_truth.txt") << "1,0.9,0.9,0.1,0.1,0\n";
+    DatasetIndex index(testDir.string(), indexPath.string());
+    auto indexed = index.getDatasetInfos();
+    auto loaded = loadDatasetInfos(testDir.string());
+
+    for (const auto& info : loaded) {
+        auto it = std::find_if(indexed.begin(), indexed.end(), [&](const DatasetInfo& d) { return d.name == info.name; });
+        ASSERT_NE(it, indexed.end());
+        EXPECT_EQ(it->ground_truth_paths, info.ground_truth_paths);
+        EXPECT_TRUE(std::is_sorted(info.ground_truth_paths.begin(), info.ground_truth_paths.end()));
+    }
+}
+
+TEST_F(DatasetIndexTest, DefaultPathIsOutsideTheDataset) {
+    fs::path sequence = testDir / "instance1";
+    fs::path default_path = fs::absolute(DatasetIndex::getDefaultPath(sequence.string()));
+    EXPECT_NE(default_path.parent_path(), fs::weakly_canonical(sequence));
+    EXPECT_NE(default_path.parent_path(), fs::weakly_canonical(testDir));
+    EXPECT_NE(DatasetIndex::getDefaultPath(sequence.string()), DatasetIndex::getDefaultPath((testDir / "instance2").string()));
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
 #include "DatasetUtils.hpp"
 
 namespace fs = std::filesystem;
@@ -67,3 +69,143 @@ TEST_F(DatasetInfoTest, HandlesNonDirectoryPath) {
     EXPECT_TRUE(info.ground_truth_paths.empty());
 }
 
+TEST_F(DatasetInfoTest, EstimatesOTBLengthFromImages) {
+    std::ofstream(testDir / "dataset2/img/0001.jpg").close();
+    std::ofstream(testDir / "dataset2/img/0002.jpg").close();
+    std::ofstream(testDir / "dataset2/img/0003.jpg").close();
+    DatasetInfo info = getDatasetInfo((testDir / "dataset2").string());
+
+    EXPECT_EQ(estimateSequenceLength(info), 3);
+}
+
+TEST_F(DatasetInfoTest, EstimatesCustomLengthFromAnnotations) {
+    std::ofstream truth(testDir / "dataset1/truth1.txt");
+    truth << "0,0.5,0.5,0.1,0.1,0\n1,0.5,0.5,0.1,0.1,0\n2\n";
+    truth.close();
+    DatasetInfo info = getDatasetInfo((testDir / "dataset1").string());
+
+    EXPECT_EQ(estimateSequenceLength(info), 3);
+}
+
+
+namespace {
+
+// Loaders as they were implemented with streams, the mapped loaders have to match them
+std::vector<Annotation> referenceOTBAnnotations(const std::string& filename)
+{
+    std::vector<Annotation> annotations;
+    std::ifstream file(filename);
+    unsigned int frame_num = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream iss(line);
+        int x, y, width, height;
+        if (iss >> x >> y >> width >> height)
+        {
+            Annotation annotation;
+            annotation.rect = cv::Rect2f(x, y, width, height);
+            annotation.frame = frame_num++;
+            annotations.push_back(annotation);
+        }
+    }
+    return annotations;
+}
+
+std::vector<Annotation> referenceCustomAnnotations(const std::string& filename)
+{
+    std::vector<Annotation> annotations;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream ss(line);
+        std::string token;
+        std::getline(ss, token, ',');
+        Annotation annotation;
+        annotation.frame = std::stoi(token);
+        if (std::getline(ss, token, ','))
+        {
+            float norm_x = std::stof(token);
+            std::getline(ss, token, ',');
+            float norm_y = std::stof(token);
+            std::getline(ss, token, ',');
+            float norm_width = std::stof(token);
+            std::getline(ss, token, ',');
+            float norm_height = std::stof(token);
+            std::getline(ss, token, ',');
+            annotation.occluded = std::stoi(token);
+            annotation.rect = cv::Rect2f(norm_x - norm_width / 2, norm_y - norm_height / 2, norm_width, norm_height);
+        }
+        annotations.push_back(annotation);
+    }
+    return annotations;
+}
+
+void expectSameAnnotations(const std::vector<Annotation>& actual, const std::vector<Annotation>& expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        EXPECT_EQ(actual[i].frame, expected[i].frame) << "annotation " << i;
+        EXPECT_EQ(actual[i].occluded, expected[i].occluded) << "annotation " << i;
+        EXPECT_EQ(actual[i].rect.x, expected[i].rect.x) << "annotation " << i;
+        EXPECT_EQ(actual[i].rect.y, expected[i].rect.y) << "annotation " << i;
+        EXPECT_EQ(actual[i].rect.width, expected[i].rect.width) << "annotation " << i;
+        EXPECT_EQ(actual[i].rect.height, expected[i].rect.height) << "annotation " << i;
+    }
+}
+
+}
+
+TEST_F(DatasetInfoTest, OTBAnnotationsMatchStreamParsing) {
+    fs::path path = testDir / "groundtruth_rect.txt";
+    std::ofstream(path) << "198,214,34,81\n197 214\t34 81\r\n+3,-4 , 5,6,7\n"
+                           "header line\n\n12.5,3,4,5\n1,2,3,99999999999\n20,21,22,23";
+
+    auto annotations = loadOTBAnnotations(path.string());
+    expectSameAnnotations(annotations, referenceOTBAnnotations(path.string()));
+    ASSERT_EQ(annotations.size(), 4);
+    EXPECT_EQ(annotations[2].rect, cv::Rect2f(3, -4, 5, 6));
+    EXPECT_EQ(annotations[3].frame, 3);
+}
+
+TEST_F(DatasetInfoTest, CustomAnnotationsMatchStreamParsing) {
+    fs::path path = testDir / "truth1.txt";
+    std::ofstream(path) << "0,0.5,0.4,0.1,0.2,0\n1\n2,\n3, 0.25,+0.5,1e-1,0.125,1,extra\r\n"
+                           "4,0.3333333,0.6666667,0.01,0.02,-1\r\n5";
+
+    auto annotations = loadCustomAnnotations(path.string());
+    expectSameAnnotations(annotations, referenceCustomAnnotations(path.string()));
+    ASSERT_EQ(annotations.size(), 6);
+    EXPECT_EQ(annotations[1].occluded, -1);
+    EXPECT_EQ(annotations[3].occluded, 1);
+}
+
+TEST_F(DatasetInfoTest, CustomAnnotationErrorsHaveLineNumbers) {
+    fs::path path = testDir / "truth1.txt";
+    std::ofstream(path) << "0,0.5,0.4,0.1,0.2,0\n1,0.5,abc,0.1,0.2,0\n";
+
+    try
+    {
+        loadCustomAnnotations(path.string());
+        FAIL() << "malformed row accepted";
+    }
+    catch (const std::invalid_argument& e)
+    {
+        EXPECT_NE(std::string(e.what()).find("truth1.txt:2: invalid y value"), std::string::npos) << e.what();
+    }
+
+    std::ofstream(path) << "0,0.5,0.4,0.1\n";
+    EXPECT_THROW(loadCustomAnnotations(path.string()), std::invalid_argument);
+}
+
+TEST_F(DatasetInfoTest, EmptyAnnotationFiles) {
+    fs::path path = testDir / "empty.txt";
+    std::ofstream(path).close();
+
+    EXPECT_TRUE(loadOTBAnnotations(path.string()).empty());
+    EXPECT_TRUE(loadCustomAnnotations(path.string()).empty());
+    EXPECT_TRUE(loadOTBAnnotations((testDir / "missing.txt").string()).empty());
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "FrameScheduler.hpp"
+
+using Scheduler = FrameScheduler<int>;
+
+TEST(FrameSchedulerTest, FullQueueDropsOldestFrame) {
+    Scheduler scheduler(1, 2);
+    scheduler.push(0, 1);
+    scheduler.push(0, 2);
+    scheduler.push(0, 3);
+    scheduler.finishStream(0);
+
+    Scheduler::Job job;
+    ASSERT_TRUE(scheduler.acquire(job));
+    EXPECT_EQ(job.frame, 2);
+    scheduler.release(0);
+    ASSERT_TRUE(scheduler.acquire(job));
+    EXPECT_EQ(job.frame, 3);
+    scheduler.release(0);
+    EXPECT_FALSE(scheduler.acquire(job));
+
+    FrameSchedulerStats stats = scheduler.getStats(0);
+    EXPECT_EQ(stats.pushed, 3);
+    EXPECT_EQ(stats.dispatched, 2);
+    EXPECT_EQ(stats.dropped_full, 1);
+}
+
+TEST(FrameSchedulerTest, StreamsAreServedRoundRobinWithOneFrameInFlight) {
+    Scheduler scheduler(2, 4);
+    scheduler.push(0, 1);
+    scheduler.push(0, 2);
+    scheduler.push(1, 10);
+
+    Scheduler::Job first, second, third;
+    ASSERT_TRUE(scheduler.acquire(first));
+    ASSERT_TRUE(scheduler.acquire(second));
+    EXPECT_EQ(first.stream, 0);
+    EXPECT_EQ(first.frame, 1);
+    EXPECT_EQ(second.stream, 1);
+    EXPECT_EQ(second.frame, 10);
+
+    // stream 0 gets its next frame only after the previous one is released
+    scheduler.release(0);
+    ASSERT_TRUE(scheduler.acquire(third));
+    EXPECT_EQ(third.stream, 0);
+    EXPECT_EQ(third.frame, 2);
+
+    scheduler.finishStream(0);
+    scheduler.finishStream(1);
+    scheduler.release(0);
+    scheduler.release(1);
+    EXPECT_FALSE(scheduler.acquire(third));
+}
+
+TEST(FrameSchedulerTest, StaleFramesAreDroppedExceptTheNewest) {
+    Scheduler scheduler(1, 8, std::chrono::milliseconds(100));
+    auto old = Scheduler::Clock::now() - std::chrono::seconds(1);
+    scheduler.push(0, 1, old);
+    scheduler.push(0, 2, old);
+    scheduler.push(0, 3, old);
+
+    Scheduler::Job job;
+    ASSERT_TRUE(scheduler.acquire(job));
+    EXPECT_EQ(job.frame, 3);
+    EXPECT_EQ(scheduler.getStats(0).dropped_stale, 2);
+}
+
+TEST(FrameSchedulerTest, StopWakesUpWaitingWorkers) {
+    Scheduler scheduler(1, 2);
+    Scheduler::Job job;
+    std::thread worker([&]() { EXPECT_FALSE(scheduler.acquire(job)); });
+    scheduler.stop();
+    worker.join();
+}
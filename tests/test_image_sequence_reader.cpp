@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+#include "ImageSequenceReader.hpp"
+
+namespace fs = std::filesystem;
+
+class ImageSequenceReaderTest : public ::testing::Test {
+protected:
+    fs::path testDir;
+    std::vector<std::string> files;
+    static const int frames = 12;
+
+    void SetUp() override {
+        testDir = fs::temp_directory_path() / "test_image_sequence_reader";
+        fs::remove_all(testDir);
+        fs::create_directories(testDir);
+        // 8x8 images filled with their index, lossless so the index survives
+        for (int i = 0; i < frames; i++) {
+            char name[16];
+            std::snprintf(name, sizeof(name), "%04d.png", i);
+            files.push_back((testDir / name).string());
+            cv::imwrite(files.back(), cv::Mat(8, 8, CV_8UC3, cv::Scalar(i, i, i)));
+        }
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    static std::vector<int> readAll(ImageSequenceReader& reader) {
+        std::vector<int> indices;
+        cv::Mat frame;
+        while (reader.getNextFrame(frame))
+            indices.push_back(frame.at<cv::Vec3b>(0, 0)[0]);
+        return indices;
+    }
+
+    static std::vector<int> range(int from, int to) {
+        std::vector<int> values;
+        for (int i = from; i < to; i++)
+            values.push_back(i);
+        return values;
+    }
+};
+
+TEST_F(ImageSequenceReaderTest, LookaheadDeliversFramesInOrder) {
+    ImageSequenceReaderArgs args;
+    args.lookahead = 4;
+    args.decode_threads = 3;
+    ImageSequenceReader reader(files, args);
+    EXPECT_EQ(readAll(reader), range(0, frames));
+    EXPECT_TRUE(reader.isDone());
+}
+
+TEST_F(ImageSequenceReaderTest, WindowIsBoundedByMemoryBudget) {
+    const size_t frame_bytes = 8 * 8 * 3;
+    ImageSequenceReaderArgs args;
+    args.lookahead = 10;
+    args.memory_budget_bytes = 2 * frame_bytes;
+    ImageSequenceReader reader(files, args);
+    cv::Mat frame;
+    ASSERT_TRUE(reader.getNextFrame(frame));
+    EXPECT_EQ(reader.getPendingDecodes(), 2);
+
+    // a budget below one image still decodes one ahead
+    args.memory_budget_bytes = frame_bytes / 2;
+    ImageSequenceReader small(files, args);
+    ASSERT_TRUE(small.getNextFrame(frame));
+    EXPECT_EQ(small.getPendingDecodes(), 1);
+    EXPECT_EQ(readAll(small), range(1, frames));
+}
+
+TEST_F(ImageSequenceReaderTest, WindowIsBoundedByLookahead) {
+    ImageSequenceReaderArgs args;
+    args.lookahead = 3;
+    ImageSequenceReader reader(files, args);
+    cv::Mat frame;
+    ASSERT_TRUE(reader.getNextFrame(frame));
+    EXPECT_EQ(reader.getPendingDecodes(), 3);
+}
+
+TEST_F(ImageSequenceReaderTest, ResetMidStreamStartsOver) {
+    ImageSequenceReaderArgs args;
+    args.lookahead = 6;
+    args.decode_threads = 2;
+    ImageSequenceReader reader(files, args);
+    cv::Mat frame;
+    for (int i = 0; i < 3; i++)
+        ASSERT_TRUE(reader.getNextFrame(frame));
+    reader.reset();
+    EXPECT_EQ(reader.getPendingDecodes(), 0);
+    EXPECT_EQ(readAll(reader), range(0, frames));
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "InferenceBackend.hpp"
+
+namespace {
+
+const std::string model = std::string(NN_MODELS_DIR) + "/vit.onnx";
+const std::vector<std::string> outputNames{ "output1", "output2", "output3" };
+
+cv::Mat randomBlob(int size, uint64_t seed)
+{
+    const int shape[] = { 1, 3, size, size };
+    cv::Mat blob(4, shape, CV_32F);
+    cv::RNG(seed).fill(blob, cv::RNG::UNIFORM, -2.0, 2.0);
+    return blob;
+}
+
+std::vector<cv::Mat> run(cv::modvit::InferenceBackend& backend)
+{
+    backend.setInput(randomBlob(128, 1), "template");
+    backend.setInput(randomBlob(256, 2), "search");
+    std::vector<cv::Mat> outputs;
+    backend.forward(outputs, outputNames);
+    return outputs;
+}
+
+void expectModelShapes(const std::vector<cv::Mat>& outputs)
+{
+    ASSERT_EQ(outputs.size(), 3);
+    EXPECT_EQ(cv::dnn::shape(outputs[0]), cv::MatShape({ 1, 1, 16, 16 }));
+    EXPECT_EQ(cv::dnn::shape(outputs[1]), cv::MatShape({ 1, 2, 16, 16 }));
+    EXPECT_EQ(cv::dnn::shape(outputs[2]), cv::MatShape({ 1, 2, 16, 16 }));
+}
+
+}
+
+TEST(InferenceBackendTest, DnnOutputsFollowRequestedNamesAndModelShapes) {
+    auto backend = cv::modvit::createInferenceBackend(cv::modvit::InferenceRuntime::OpenCVDnn, model,
+        cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU, 0);
+    expectModelShapes(run(*backend));
+
+    // outputs come back in the requested order, not the order of the graph
+    std::vector<cv::Mat> reordered;
+    backend->forward(reordered, { "output3", "output1" });
+    ASSERT_EQ(reordered.size(), 2);
+    EXPECT_EQ(cv::dnn::shape(reordered[0]), cv::MatShape({ 1, 2, 16, 16 }));
+    EXPECT_EQ(cv::dnn::shape(reordered[1]), cv::MatShape({ 1, 1, 16, 16 }));
+}
+
+#ifdef HAVE_ONNXRUNTIME
+TEST(InferenceBackendTest, OrtMatchesDnnWithinTolerance) {
+    auto dnn = cv::modvit::createInferenceBackend(cv::modvit::InferenceRuntime::OpenCVDnn, model,
+        cv::dnn::DNN_BACKEND_OPENCV, cv::dnn::DNN_TARGET_CPU, 0);
+    auto ort = cv::modvit::createInferenceBackend(cv::modvit::InferenceRuntime::OnnxRuntime, model, 0, 0, 1);
+    std::vector<cv::Mat> expected = run(*dnn);
+    std::vector<cv::Mat> outputs = run(*ort);
+
+    expectModelShapes(outputs);
+    for (size_t i = 0; i < outputs.size(); i++)
+        EXPECT_LE(cv::norm(outputs[i], expected[i], cv::NORM_INF), 1e-3) << outputNames[i];
+}
+
+TEST(InferenceBackendTest, OrtReusesOutputBuffers) {
+    auto ort = cv::modvit::createInferenceBackend(cv::modvit::InferenceRuntime::OnnxRuntime, model, 0, 0, 1);
+    std::vector<cv::Mat> first = run(*ort);
+    std::vector<cv::Mat> second = run(*ort);
+    for (size_t i = 0; i < first.size(); i++)
+        EXPECT_EQ(first[i].data, second[i].data);
+}
+#endif
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "LatencyHistogram.hpp"
+
+TEST(LatencyHistogramTest, PercentilesWithinPrecision) {
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 1000; i++)
+        histogram.record(i * 1e-4); // 0.1 ms .. 100 ms
+
+    EXPECT_EQ(histogram.getCount(), 1000);
+    EXPECT_NEAR(histogram.getPercentile(50), 0.05, 0.05 / 128);
+    EXPECT_NEAR(histogram.getPercentile(99), 0.099, 0.099 / 128);
+    EXPECT_DOUBLE_EQ(histogram.getMax(), 0.1);
+    EXPECT_DOUBLE_EQ(histogram.getPercentile(100), 0.1);
+}
+
+TEST(LatencyHistogramTest, FractionAboveDeadline) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 90; i++)
+        histogram.record(0.010);
+    for (int i = 0; i < 10; i++)
+        histogram.record(0.050);
+
+    EXPECT_DOUBLE_EQ(histogram.getFractionAbove(0.0333), 0.1);
+    EXPECT_DOUBLE_EQ(histogram.getFractionAbove(0.1), 0.0);
+}
+
+TEST(LatencyHistogramTest, MergeEqualsRecordingEverything) {
+    LatencyHistogram first, second, all;
+    for (int i = 0; i < 500; i++)
+    {
+        first.record(i * 1e-5);
+        all.record(i * 1e-5);
+        second.record(i * 3e-4);
+        all.record(i * 3e-4);
+    }
+    first.merge(second);
+
+    EXPECT_EQ(first.getCount(), all.getCount());
+    EXPECT_EQ(first.getCounts(), all.getCounts());
+    EXPECT_DOUBLE_EQ(first.getMax(), all.getMax());
+    EXPECT_DOUBLE_EQ(first.getPercentile(99.9), all.getPercentile(99.9));
+}
+
+TEST(LatencyHistogramTest, YAMLRoundTrip) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 100; i++)
+        histogram.record(i * 7e-4);
+
+    YAML::Emitter out;
+    out << histogram;
+    LatencyHistogram restored = LatencyHistogram::fromYAML(YAML::Load(out.c_str()));
+
+    EXPECT_EQ(restored.getCounts(), histogram.getCounts());
+    EXPECT_EQ(restored.getCount(), histogram.getCount());
+    EXPECT_DOUBLE_EQ(restored.getMax(), histogram.getMax());
+}
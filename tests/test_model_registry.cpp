@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include "ModelRegistry.hpp"
+
+namespace fs = std::filesystem;
+
+class ModelRegistryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / "model_registry_test";
+        fs::create_directories(dir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+    }
+
+    std::string writeModel(const std::string& name, const std::string& content) {
+        std::string path = (dir / name).string();
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    fs::path dir;
+};
+
+TEST_F(ModelRegistryTest, SamePathSharesMapping) {
+    std::string path = writeModel("a.onnx", "weights");
+    auto first = ModelRegistry::instance().acquire(path);
+    auto second = ModelRegistry::instance().acquire(path);
+
+    EXPECT_EQ(first.get(), second.get());
+    ASSERT_EQ(first->size(), 7u);
+    EXPECT_EQ(std::string(first->data(), first->size()), "weights");
+}
+
+TEST_F(ModelRegistryTest, SameContentUnderOtherPathSharesMapping) {
+    auto first = ModelRegistry::instance().acquire(writeModel("a.onnx", "identical"));
+    auto second = ModelRegistry::instance().acquire(writeModel("b.onnx", "identical"));
+    auto other = ModelRegistry::instance().acquire(writeModel("c.onnx", "different"));
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_NE(first.get(), other.get());
+    EXPECT_NE(first->getHash(), other->getHash());
+}
+
+TEST_F(ModelRegistryTest, ChangedFileIsMappedAgain) {
+    std::string path = writeModel("a.onnx", "old weights");
+    auto old_model = ModelRegistry::instance().acquire(path);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // replaced by rename, as files under a live mapping must not be rewritten in place
+    fs::rename(writeModel("a.onnx.tmp", "new weights!"), path);
+    auto new_model = ModelRegistry::instance().acquire(path);
+
+    EXPECT_NE(old_model.get(), new_model.get());
+    EXPECT_EQ(std::string(new_model->data(), new_model->size()), "new weights!");
+    EXPECT_EQ(std::string(old_model->data(), old_model->size()), "old weights");
+}
+
+TEST_F(ModelRegistryTest, MissingFileThrows) {
+    EXPECT_THROW(ModelRegistry::instance().acquire((dir / "missing.onnx").string()), std::runtime_error);
+}
+
+TEST_F(ModelRegistryTest, HeldModelsAreCountedOnce) {
+    std::string path = writeModel("held.onnx", "held weights");
+    auto first = ModelRegistry::instance().acquire(path);
+    ModelRegistryStats before = ModelRegistry::instance().getStats();
+    auto second = ModelRegistry::instance().acquire(path);
+    ModelRegistryStats after = ModelRegistry::instance().getStats();
+
+    EXPECT_GE(before.models, 1u);
+    EXPECT_GE(before.mapped_bytes, first->size());
+    EXPECT_EQ(after.models, before.models);
+    EXPECT_EQ(after.mapped_bytes, before.mapped_bytes);
+    EXPECT_EQ(after.shared_hits, before.shared_hits + 1);
+}
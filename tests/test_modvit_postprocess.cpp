@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include "ModVITPostprocess.hpp"
+
+TEST(ModVITPostprocessTest, ClearBestCandidateIsKept) {
+    std::vector<cv::Rect> rects = { {0, 0, 10, 10}, {100, 100, 10, 10}, {102, 100, 10, 10}, {101, 101, 10, 10}, {100, 102, 10, 10} };
+    std::vector<double> scores = { 0.9, 0.5, 0.4, 0.3, 0.2 };
+
+    EXPECT_EQ(cv::modvit::fuseCandidates(rects, scores), 0);
+}
+
+TEST(ModVITPostprocessTest, SimilarScoresPreferSupportedCandidate) {
+    // the best box is isolated, the second one overlaps with the rest of the candidates
+    std::vector<cv::Rect> rects = { {0, 0, 10, 10}, {100, 100, 10, 10}, {300, 300, 10, 10}, {101, 101, 10, 10}, {100, 102, 10, 10} };
+    std::vector<double> scores = { 0.5, 0.45, 0.2, 0.4, 0.4 };
+
+    EXPECT_EQ(cv::modvit::fuseCandidates(rects, scores), 1);
+}
+
+TEST(ModVITPostprocessTest, TopCandidatesAreSortedAndDistinct) {
+    cv::Mat conf_map = cv::Mat::zeros(16, 16, CV_32F);
+    conf_map.at<float>(3, 4) = 0.9f;
+    conf_map.at<float>(8, 8) = 0.7f;
+    conf_map.at<float>(12, 1) = 0.5f;
+    const int sizes[] = { 2, 16, 16 };
+    cv::Mat size_map(3, sizes, CV_32F, cv::Scalar(0.25));
+    cv::Mat offset_map(3, sizes, CV_32F, cv::Scalar(0.5));
+
+    cv::Mat scratch;
+    std::vector<cv::Rect> rects;
+    std::vector<double> scores;
+    cv::modvit::findTopCandidates(conf_map, size_map, offset_map, cv::Rect(100, 100, 40, 40), 3, scratch, rects, scores);
+
+    ASSERT_EQ(rects.size(), 3u);
+    EXPECT_FLOAT_EQ(scores[0], 0.9f);
+    EXPECT_FLOAT_EQ(scores[1], 0.7f);
+    EXPECT_FLOAT_EQ(scores[2], 0.5f);
+    EXPECT_LT(rects[0].x, rects[1].x);
+    // the input map is left untouched
+    EXPECT_FLOAT_EQ(conf_map.at<float>(3, 4), 0.9f);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <opencv2/opencv.hpp>
+#include "ModVITPreprocess.hpp"
+
+namespace {
+
+// Normalization of the resized patch as TrackerModVIT did it originally, with Mat expressions
+cv::Mat referenceNormalize(const cv::Mat& img, const cv::Scalar& meanvalue, const cv::Scalar& stdvalue)
+{
+    cv::Mat mean = cv::Mat(img.size(), CV_32FC3, meanvalue);
+    cv::Mat std = cv::Mat(img.size(), CV_32FC3, stdvalue);
+    mean = cv::dnn::blobFromImage(mean, 1.0, cv::Size(), cv::Scalar(), false);
+    std = cv::dnn::blobFromImage(std, 1.0, cv::Size(), cv::Scalar(), false);
+
+    cv::Mat dst = cv::dnn::blobFromImage(img, 1.0, cv::Size(), cv::Scalar(), false);
+    dst /= 255;
+    dst = (dst - mean) / std;
+    return dst;
+}
+
+}
+
+TEST(ModVITPreprocessTest, MatchesReferenceBitForBit) {
+    const cv::Scalar meanvalue{ 0.485, 0.456, 0.406 };
+    const cv::Scalar stdvalue{ 0.229, 0.224, 0.225 };
+    cv::modvit::NormalizationConstants constants(meanvalue, stdvalue);
+    cv::RNG rng(42);
+
+    // template and search patch sizes, as produced by cropResizedPatch
+    for (cv::Size size : { cv::Size(128, 128), cv::Size(256, 256) })
+    {
+        cv::Mat patch(size, CV_8UC3);
+        rng.fill(patch, cv::RNG::UNIFORM, 0, 256);
+
+        cv::Mat expected = referenceNormalize(patch, meanvalue, stdvalue);
+        cv::Mat blob;
+        cv::modvit::normalizeToBlob(patch, blob, constants);
+
+        ASSERT_TRUE(blob.size == expected.size);
+        ASSERT_EQ(blob.type(), expected.type());
+        EXPECT_EQ(0, std::memcmp(blob.ptr<float>(), expected.ptr<float>(), expected.total() * expected.elemSize()));
+    }
+}
+
+TEST(ModVITPreprocessTest, ReusesBuffers) {
+    cv::modvit::NormalizationConstants constants(cv::Scalar(0.5, 0.5, 0.5), cv::Scalar(0.25, 0.25, 0.25));
+    cv::Mat patch(256, 256, CV_8UC3, cv::Scalar(10, 20, 30));
+    cv::Mat blob;
+    cv::modvit::normalizeToBlob(patch, blob, constants);
+    const uchar* blob_data = blob.data;
+
+    cv::modvit::normalizeToBlob(patch, blob, constants);
+
+    EXPECT_EQ(blob.data, blob_data);
+}
+
+namespace {
+
+// Crop, pad and resize as TrackerModVIT did it before cropResizedPatch
+cv::Mat referenceCropResize(const cv::Mat& src, cv::Rect box, int factor, cv::Size size)
+{
+    int x = box.x, y = box.y, w = box.width, h = box.height;
+    int cropSz = static_cast<int>(std::ceil(std::sqrt(w * h) * factor));
+
+    int x1 = x + (w - cropSz) / 2;
+    int x2 = x1 + cropSz;
+    int y1 = y + (h - cropSz) / 2;
+    int y2 = y1 + cropSz;
+
+    int x1_pad = std::max(0, -x1);
+    int y1_pad = std::max(0, -y1);
+    int x2_pad = std::max(x2 - src.size[1] + 1, 0);
+    int y2_pad = std::max(y2 - src.size[0] + 1, 0);
+
+    cv::Rect roi(x1 + x1_pad, y1 + y1_pad, x2 - x2_pad - x1 - x1_pad, y2 - y2_pad - y1 - y1_pad);
+    cv::Mat padded, resized;
+    cv::copyMakeBorder(src(roi), padded, y1_pad, y2_pad, x1_pad, x2_pad, cv::BORDER_CONSTANT);
+    cv::resize(padded, resized, size);
+    return resized;
+}
+
+// Smooth frame, so the sub-pixel sampling differences of warpAffine and resize stay within a few levels
+cv::Mat smoothFrame(cv::Size size)
+{
+    cv::Mat frame(size, CV_8UC3);
+    for (int y = 0; y < size.height; y++)
+        for (int x = 0; x < size.width; x++)
+            for (int c = 0; c < 3; c++)
+                frame.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(127.5 + 100 * std::sin(x / 7.0 + c) * std::cos(y / 11.0 - c));
+    return frame;
+}
+
+}
+
+TEST(ModVITPreprocessTest, CropResizedPatchMatchesCropPadResize) {
+    cv::Mat frame = smoothFrame(cv::Size(320, 240));
+    struct Case { cv::Rect box; int factor; cv::Size size; };
+    // template (factor 2, mostly upscaled) and search (factor 4, mostly downscaled) windows,
+    // inside the frame and crossing each of its edges
+    std::vector<Case> cases = {
+        { cv::Rect(140, 100, 40, 30), 2, cv::Size(128, 128) },
+        { cv::Rect(130, 95, 50, 40), 4, cv::Size(256, 256) },
+        { cv::Rect(5, 7, 40, 30), 2, cv::Size(128, 128) },
+        { cv::Rect(3, 4, 60, 50), 4, cv::Size(256, 256) },
+        { cv::Rect(270, 200, 45, 35), 2, cv::Size(128, 128) },
+        { cv::Rect(250, 180, 60, 50), 4, cv::Size(256, 256) },
+    };
+
+    for (const auto& c : cases)
+    {
+        cv::Mat expected = referenceCropResize(frame, c.box, c.factor, c.size);
+        cv::Mat patch;
+        cv::modvit::cropResizedPatch(frame, patch, c.box, c.factor, c.size);
+
+        ASSERT_EQ(patch.size(), expected.size());
+        ASSERT_EQ(patch.type(), expected.type());
+        cv::Mat diff;
+        cv::absdiff(patch, expected, diff);
+        double max_diff;
+        cv::minMaxLoc(diff.reshape(1), nullptr, &max_diff);
+        cv::Scalar mean_diff = cv::mean(diff);
+        EXPECT_LE(max_diff, 4) << c.box;
+        for (int ch = 0; ch < 3; ch++)
+            EXPECT_LE(mean_diff[ch], 0.5) << c.box;
+    }
+}
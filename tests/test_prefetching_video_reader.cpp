@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "PrefetchingVideoReader.hpp"
+
+namespace {
+
+// Frames filled with their index, decoded into the buffer it is given like cv::VideoCapture does
+class NumberedReader : public VideoReader {
+public:
+    explicit NumberedReader(int frames) : frames(frames) {}
+
+    bool getNextFrame(cv::Mat& frame) override {
+        if (next >= frames) {
+            done = true;
+            return false;
+        }
+        frame.create(2, 2, CV_32S);
+        frame.setTo(cv::Scalar(next));
+        next++;
+        return true;
+    }
+    bool isDone() const override { return done; }
+    void reset() override { next = 0; done = false; }
+    double getFps() const override { return 30; }
+
+private:
+    int frames;
+    int next = 0;
+    bool done = false;
+};
+
+std::vector<int> readAll(VideoReader& reader) {
+    std::vector<int> indices;
+    cv::Mat frame;
+    while (reader.getNextFrame(frame))
+        indices.push_back(frame.at<int>(0, 0));
+    return indices;
+}
+
+std::vector<int> range(int from, int to) {
+    std::vector<int> values;
+    for (int i = from; i < to; i++)
+        values.push_back(i);
+    return values;
+}
+
+}
+
+TEST(PrefetchingVideoReaderTest, DeliversFramesInOrderAcrossTheRing) {
+    PrefetchingVideoReader reader(std::make_unique<NumberedReader>(10), 3);
+    EXPECT_DOUBLE_EQ(reader.getFps(), 30);
+    EXPECT_EQ(readAll(reader), range(0, 10));
+    EXPECT_TRUE(reader.isDone());
+    EXPECT_EQ(reader.getStats().frames_delivered, 10);
+}
+
+TEST(PrefetchingVideoReaderTest, IsDoneOnceTheLastFrameIsHandedOut) {
+    PrefetchingVideoReader reader(std::make_unique<NumberedReader>(3), 4);
+    cv::Mat frame;
+    ASSERT_TRUE(reader.getNextFrame(frame));
+    ASSERT_TRUE(reader.getNextFrame(frame));
+    EXPECT_FALSE(reader.isDone());
+    ASSERT_TRUE(reader.getNextFrame(frame));
+
+    // the decoder finds out the source ended on its own, no failing getNextFrame is needed
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!reader.isDone() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_TRUE(reader.isDone());
+    EXPECT_FALSE(reader.getNextFrame(frame));
+}
+
+TEST(PrefetchingVideoReaderTest, ResetMidStreamStartsOver) {
+    PrefetchingVideoReader reader(std::make_unique<NumberedReader>(10), 2);
+    cv::Mat frame;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(reader.getNextFrame(frame));
+        EXPECT_EQ(frame.at<int>(0, 0), i);
+    }
+    reader.reset();
+    EXPECT_FALSE(reader.isDone());
+    EXPECT_EQ(readAll(reader), range(0, 10));
+}
+
+TEST(PrefetchingVideoReaderTest, KeptFrameIsNotDecodedInto) {
+    PrefetchingVideoReader reader(std::make_unique<NumberedReader>(20), 2);
+    cv::Mat frame;
+    ASSERT_TRUE(reader.getNextFrame(frame));
+    cv::Mat kept = frame; // shares the buffer, which goes back to the ring on the next call
+    std::vector<int> indices;
+    while (reader.getNextFrame(frame))
+        indices.push_back(frame.at<int>(0, 0));
+    EXPECT_EQ(indices, range(1, 20));
+    EXPECT_EQ(kept.at<int>(0, 0), 0);
+    EXPECT_EQ(kept.at<int>(1, 1), 0);
+}
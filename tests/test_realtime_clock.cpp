@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "RealtimeClock.hpp"
+
+namespace {
+
+const double frame_interval = 0.1;
+
+// Runs a tracker taking the given time per update over the frames, returns the frames it was given
+std::vector<unsigned> runClock(const std::vector<double>& processing_times, unsigned frames) {
+    RealtimeClock clock;
+    std::vector<unsigned> updated;
+    clock.update(0, frame_interval, 0, cv::Rect()); // init on the first frame
+    for (unsigned frame = 1; frame < frames; frame++) {
+        if (!clock.isFrameDue(frame, frame_interval))
+            continue;
+        clock.update(frame, frame_interval, processing_times[updated.size() % processing_times.size()], cv::Rect(frame, 0, 1, 1));
+        updated.push_back(frame);
+    }
+    return updated;
+}
+
+}
+
+TEST(RealtimeClockTest, FastTrackerGetsEveryFrame) {
+    EXPECT_EQ(runClock({ 0.05 }, 6), std::vector<unsigned>({ 1, 2, 3, 4, 5 }));
+}
+
+TEST(RealtimeClockTest, TrackerFreeExactlyAtTheNextFrameTakesIt) {
+    EXPECT_EQ(runClock({ 0.1 }, 6), std::vector<unsigned>({ 1, 2, 3, 4, 5 }));
+}
+
+TEST(RealtimeClockTest, SlowTrackerSkipsFramesArrivingWhileBusy) {
+    // the update of frame 1 ends at 0.35, frames 2 and 3 arrived meanwhile and only the newest is taken
+    EXPECT_EQ(runClock({ 0.25 }, 10), std::vector<unsigned>({ 1, 3, 6, 8 }));
+}
+
+TEST(RealtimeClockTest, TrackerWhichFreesBetweenFramesWaitsForTheNextOne) {
+    // free at 0.25 after frame 1 and takes frame 2 which arrived at 0.2, after its short update it waits for frame 3
+    EXPECT_EQ(runClock({ 0.15, 0.02 }, 5), std::vector<unsigned>({ 1, 2, 3, 4 }));
+}
+
+TEST(RealtimeClockTest, KeepsTheLastOutputForSkippedFrames) {
+    RealtimeClock clock;
+    clock.update(0, frame_interval, 0.3, cv::Rect(1, 2, 3, 4));
+    EXPECT_FALSE(clock.isFrameDue(1, frame_interval));
+    EXPECT_FALSE(clock.isFrameDue(2, frame_interval));
+    EXPECT_TRUE(clock.isFrameDue(3, frame_interval));
+    EXPECT_EQ(clock.last_bbox, cv::Rect(1, 2, 3, 4));
+    EXPECT_EQ(clock.last_frame, 0);
+}
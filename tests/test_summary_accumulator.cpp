@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numeric>
+#include "SummaryAccumulator.hpp"
+
+namespace {
+
+double mean(const std::vector<double>& values) {
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+double sampleStd(const std::vector<double>& values) {
+    double m = mean(values);
+    double sum = 0;
+    for (double v : values)
+        sum += (v - m) * (v - m);
+    return std::sqrt(sum / (values.size() - 1));
+}
+
+// Summary of a sequence whose valid frames have the given values, computed like TrackerPerformanceEvaluator does
+SequenceTrackingSummary makeSummary(const std::vector<double>& values, size_t invalid_frames, unsigned reinits) {
+    SequenceTrackingSummary summary;
+    summary.avg_overlap = mean(values);
+    summary.avg_overlap_std = sampleStd(values);
+    summary.avg_cle = mean(values) * 10;
+    summary.avg_cle_std = sampleStd(values) * 10;
+    summary.avg_time = mean(values) / 100;
+    summary.avg_time_std = sampleStd(values) / 100;
+    summary.frames = values.size() + invalid_frames;
+    summary.valid_frames = values.size();
+    summary.timed_frames = values.size();
+    summary.success_rt = summary.valid_frames / static_cast<double>(summary.frames);
+    summary.reinit_cnt = reinits;
+    summary.deadline = 0.005;
+    size_t misses = 0;
+    for (double v : values) {
+        summary.latency_histogram.record(v / 100);
+        if (v / 100 > summary.deadline)
+            misses++;
+    }
+    summary.deadline_miss_rt = misses / static_cast<double>(values.size());
+    summary.avg_stage_times = { { "inference", mean(values) / 200 } };
+    return summary;
+}
+
+}
+
+TEST(SummaryAccumulatorTest, EqualsOneSequenceWithAllFrames) {
+    std::vector<double> first = { 0.9, 0.8, 0.85, 0.7 };
+    std::vector<double> second = { 0.2, 0.4, 0.3, 0.6, 0.5, 0.1, 0.35, 0.45, 0.55, 0.25 };
+    std::vector<double> all = first;
+    all.insert(all.end(), second.begin(), second.end());
+
+    SummaryAccumulator accumulator;
+    accumulator.add(makeSummary(first, 1, 1));
+    accumulator.add(makeSummary(second, 5, 2));
+    SequenceTrackingSummary merged = accumulator.getSummary();
+    SequenceTrackingSummary expected = makeSummary(all, 6, 3);
+
+    EXPECT_EQ(accumulator.getSequenceCount(), 2);
+    EXPECT_EQ(merged.frames, expected.frames);
+    EXPECT_EQ(merged.valid_frames, expected.valid_frames);
+    EXPECT_EQ(merged.reinit_cnt, 3);
+    EXPECT_NEAR(merged.success_rt, expected.success_rt, 1e-12);
+    EXPECT_NEAR(merged.avg_overlap, expected.avg_overlap, 1e-12);
+    EXPECT_NEAR(merged.avg_overlap_std, expected.avg_overlap_std, 1e-12);
+    EXPECT_NEAR(merged.avg_cle, expected.avg_cle, 1e-12);
+    EXPECT_NEAR(merged.avg_cle_std, expected.avg_cle_std, 1e-12);
+    EXPECT_NEAR(merged.avg_time_std, expected.avg_time_std, 1e-12);
+    EXPECT_NEAR(merged.deadline_miss_rt, expected.deadline_miss_rt, 1e-12);
+    EXPECT_DOUBLE_EQ(merged.time_p90, expected.latency_histogram.getPercentile(90.0));
+    EXPECT_EQ(merged.latency_histogram.getCount(), all.size());
+    ASSERT_EQ(merged.avg_stage_times.size(), 1);
+    EXPECT_NEAR(merged.avg_stage_times[0].second, expected.avg_stage_times[0].second, 1e-12);
+}
+
+TEST(SummaryAccumulatorTest, MergingAccumulatorsEqualsAddingAll) {
+    std::vector<std::vector<double>> sequences = { { 0.5, 0.6 }, { 0.1 }, { 0.9, 0.3, 0.4 } };
+    SummaryAccumulator all, first, rest;
+    for (size_t i = 0; i < sequences.size(); i++) {
+        all.add(makeSummary(sequences[i], i, 0));
+        (i == 0 ? first : rest).add(makeSummary(sequences[i], i, 0));
+    }
+    first.merge(rest);
+
+    EXPECT_EQ(first.getSequenceCount(), 3);
+    EXPECT_NEAR(first.getSummary().avg_overlap, all.getSummary().avg_overlap, 1e-12);
+    EXPECT_NEAR(first.getSummary().avg_overlap_std, all.getSummary().avg_overlap_std, 1e-12);
+    EXPECT_NEAR(first.getSummary().success_rt, all.getSummary().success_rt, 1e-12);
+}
+
+TEST(SummaryAccumulatorTest, SequencesWithoutValidFramesOnlyCountFrames) {
+    SequenceTrackingSummary lost;
+    lost.avg_overlap = 0;
+    lost.avg_overlap_std = 0;
+    lost.avg_cle = 0;
+    lost.avg_cle_std = 0;
+    lost.avg_time = 0;
+    lost.avg_time_std = 0;
+    lost.deadline_miss_rt = 0;
+    lost.reinit_cnt = 0;
+    lost.frames = 10;
+    lost.valid_frames = 0;
+
+    SummaryAccumulator accumulator;
+    accumulator.add(makeSummary({ 0.5, 0.7 }, 0, 0));
+    accumulator.add(lost);
+
+    EXPECT_NEAR(accumulator.getSummary().avg_overlap, 0.6, 1e-12);
+    EXPECT_NEAR(accumulator.getSummary().success_rt, 2.0 / 12, 1e-12);
+}
+
+TEST(SummaryAccumulatorTest, RealtimeSkippedFramesAreSummedFromSavedSummaries) {
+    SequenceTrackingSummary first = makeSummary({ 0.5, 0.7, 0.6 }, 1, 0);
+    first.realtime = true;
+    first.skipped_frames = 2;
+    SequenceTrackingSummary second = makeSummary({ 0.4, 0.3 }, 0, 1);
+    second.realtime = true;
+    second.skipped_frames = 5;
+
+    SummaryAccumulator accumulator;
+    for (const auto& summary : { first, second }) {
+        YAML::Emitter out;
+        out << summary;
+        accumulator.add(summaryFromYAML(YAML::Load(out.c_str())));
+    }
+
+    EXPECT_TRUE(accumulator.getSummary().realtime);
+    EXPECT_EQ(accumulator.getSummary().skipped_frames, 7);
+    EXPECT_FALSE(makeSummary({ 0.5 }, 0, 0).realtime);
+}
+
+TEST(SummaryAccumulatorTest, TimesArePooledOverTimedFrames) {
+    // two of the four valid frames of the first sequence were skipped, their times are not in its averages
+    SequenceTrackingSummary first = makeSummary({ 0.5, 0.7, 0.6, 0.4 }, 0, 0);
+    first.timed_frames = 2;
+    first.avg_time = 0.01;
+    first.avg_time_std = 0;
+    first.avg_stage_times = { { "inference", 0.004 } };
+    SequenceTrackingSummary second = makeSummary({ 0.3, 0.2 }, 0, 0);
+    second.avg_time = 0.03;
+    second.avg_time_std = 0;
+    second.avg_stage_times = { { "inference", 0.008 } };
+
+    SummaryAccumulator accumulator;
+    accumulator.add(first);
+    accumulator.add(second);
+    SequenceTrackingSummary merged = accumulator.getSummary();
+
+    EXPECT_EQ(merged.valid_frames, 6);
+    EXPECT_EQ(merged.timed_frames, 4);
+    EXPECT_NEAR(merged.avg_time, 0.02, 1e-12);
+    EXPECT_NEAR(merged.avg_time_std, sampleStd({ 0.01, 0.01, 0.03, 0.03 }), 1e-12);
+    ASSERT_EQ(merged.avg_stage_times.size(), 1);
+    EXPECT_NEAR(merged.avg_stage_times[0].second, 0.006, 1e-12);
+}
+
+TEST(SummaryAccumulatorTest, TimedFramesDefaultToValidFrames) {
+    SequenceTrackingSummary summary = makeSummary({ 0.5, 0.7, 0.6 }, 1, 0);
+    summary.timed_frames = 2;
+    YAML::Emitter out;
+    out << summary;
+    YAML::Node node = YAML::Load(out.c_str());
+    EXPECT_EQ(summaryFromYAML(node).timed_frames, 2);
+
+    node.remove("timed_frames");
+    EXPECT_EQ(summaryFromYAML(node).timed_frames, 3);
+}
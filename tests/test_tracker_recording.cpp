@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "TrackerRecording.hpp"
+
+namespace fs = std::filesystem;
+
+class TrackerRecordingTest : public ::testing::Test {
+protected:
+    fs::path filename;
+
+    void SetUp() override {
+        filename = fs::temp_directory_path() / "test_tracker_record.csv";
+    }
+
+    void TearDown() override {
+        fs::remove(filename);
+    }
+};
+
+TEST_F(TrackerRecordingTest, SaveAndLoadAreExact) {
+    TrackerRecording recording;
+    recording.stage_names = { "preprocess", "inference" };
+    RecordedFrame tracked;
+    tracked.ground_truth = cv::Rect(10, 20, 30, 40);
+    tracked.occluded = 0;
+    tracked.updated = true;
+    tracked.bbox = cv::Rect(12, 21, 29, 41);
+    tracked.score = 0.1 + 0.2;
+    tracked.state = "Tracking";
+    tracked.processing_time = 1.0 / 3;
+    tracked.stage_times = { 0.001, 1e-7 };
+    tracked.reinited = true;
+    RecordedFrame lost;
+    lost.state = "Lost";
+    recording.frames = { tracked, lost };
+
+    recording.saveToFile(filename.string());
+    TrackerRecording loaded = TrackerRecording::loadFromFile(filename.string());
+
+    EXPECT_EQ(loaded.stage_names, recording.stage_names);
+    ASSERT_EQ(loaded.frames.size(), 2);
+    const RecordedFrame& frame = loaded.frames[0];
+    EXPECT_EQ(frame.ground_truth, tracked.ground_truth);
+    EXPECT_EQ(frame.occluded, 0);
+    EXPECT_TRUE(frame.updated);
+    EXPECT_EQ(frame.bbox, tracked.bbox);
+    EXPECT_EQ(frame.score, tracked.score);
+    EXPECT_EQ(frame.state, "Tracking");
+    EXPECT_EQ(frame.processing_time, tracked.processing_time);
+    EXPECT_EQ(frame.stage_times, tracked.stage_times);
+    EXPECT_TRUE(frame.reinited);
+    EXPECT_FALSE(loaded.frames[1].updated);
+    EXPECT_EQ(loaded.frames[1].state, "Lost");
+    EXPECT_EQ(loaded.frames[1].stage_times, std::vector<double>({ -1.0, -1.0 }));
+}
+
+TEST_F(TrackerRecordingTest, RejectsMalformedRows) {
+    TrackerRecording recording;
+    recording.frames.resize(1);
+    recording.saveToFile(filename.string());
+    std::ofstream(filename, std::ios::app) << "2,1,2,3\n";
+
+    EXPECT_THROW(TrackerRecording::loadFromFile(filename.string()), std::runtime_error);
+}
+
+TEST_F(TrackerRecordingTest, RejectsOtherFiles) {
+    std::ofstream(filename) << "Frame,Overlap,Center Error,Processing Time,BBox Area,Valid\n";
+
+    EXPECT_THROW(TrackerRecording::loadFromFile(filename.string()), std::runtime_error);
+}
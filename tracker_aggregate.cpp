@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "spdlog/cfg/env.h"
+#include <yaml-cpp/yaml.h>
+#include "ColumnarResults.hpp"
+#include "SequenceTrackingSummary.hpp"
+#include "SummaryAccumulator.hpp"
+
+namespace fs = std::filesystem;
+
+// Summaries written before they carried frame counts get them from the per-frame results next to them
+bool readFrameCounts(const fs::path& sequence_dir, const std::string& tracker_name, SequenceTrackingSummary& summary)
+{
+  fs::path columnar_path = sequence_dir / (tracker_name + "_results.tcr");
+  if (fs::exists(columnar_path))
+  {
+    ColumnarResultsReader reader(columnar_path.string());
+    const uint8_t* valid = reader.getColumn<uint8_t>("valid");
+    summary.frames = reader.getRows();
+    summary.valid_frames = std::count(valid, valid + reader.getRows(), 1);
+    summary.timed_frames = summary.valid_frames;
+    return true;
+  }
+  std::ifstream csv_file(sequence_dir / (tracker_name + "_results.csv"));
+  if (!csv_file.is_open())
+    return false;
+  std::string line;
+  std::getline(csv_file, line); // header
+  summary.frames = 0;
+  summary.valid_frames = 0;
+  while (std::getline(csv_file, line))
+  {
+    // Frame,Overlap,Center Error,Processing Time,BBox Area,Valid[,stage times]
+    size_t field_start = 0;
+    for (int field = 0; field < 5 && field_start != std::string::npos; field++)
+      field_start = line.find(',', field_start + 1);
+    if (field_start == std::string::npos)
+      continue;
+    summary.frames++;
+    if (line.compare(field_start + 1, 1, "1") == 0)
+      summary.valid_frames++;
+  }
+  summary.timed_frames = summary.valid_frames; // written before the real-time mode, nothing was skipped
+  return true;
+}
+
+// Adds every tracker summary of a sequence, other top level entries (model_load, replay, ...) are skipped
+void addSequenceSummary(const fs::path& summary_path, std::map<std::string, SummaryAccumulator>& run_trackers)
+{
+  YAML::Node summary_file = YAML::LoadFile(summary_path.string());
+  for (const auto& entry : summary_file)
+  {
+    if (!entry.second.IsMap() || !entry.second["avg_overlap"])
+      continue;
+    std::string tracker_name = entry.first.as<std::string>();
+    SequenceTrackingSummary summary = summaryFromYAML(entry.second);
+    if (!entry.second["frames"] && !readFrameCounts(summary_path.parent_path(), tracker_name, summary))
+    {
+      spdlog::warn("No frame counts for {} in {}, skipping it", tracker_name, summary_path.string());
+      continue;
+    }
+    run_trackers[tracker_name].add(summary);
+  }
+}
+
+// A directory with a config.yaml is a single run, otherwise every such subdirectory is one
+std::vector<fs::path> findRuns(const fs::path& path)
+{
+  if (fs::exists(path / "config.yaml"))
+    return { path };
+  std::vector<fs::path> runs;
+  for (const auto& entry : fs::directory_iterator(path))
+  {
+    if (entry.is_directory() && fs::exists(entry.path() / "config.yaml"))
+      runs.push_back(entry.path());
+  }
+  std::sort(runs.begin(), runs.end());
+  if (runs.empty())
+    runs.push_back(path);
+  return runs;
+}
+
+void writeTableHeader(std::ofstream& table, const std::string& key_columns)
+{
+  table << key_columns << ",sequences,frames,valid_frames,SR,avg_overlap,avg_overlap_std,avg_cle,avg_cle_std,avg_time,avg_time_std,"
+    "time_p50,time_p90,time_p99,time_max,deadline_miss_rt,skipped_frames,RC\n";
+}
+
+void writeTableRow(std::ofstream& table, const std::string& key_values, const SummaryAccumulator& accumulator)
+{
+  SequenceTrackingSummary summary = accumulator.getSummary();
+  table << key_values << "," << accumulator.getSequenceCount() << "," << summary.frames << "," << summary.valid_frames << ","
+    << summary.success_rt << "," << summary.avg_overlap << "," << summary.avg_overlap_std << "," << summary.avg_cle << ","
+    << summary.avg_cle_std << "," << summary.avg_time << "," << summary.avg_time_std << "," << summary.time_p50 << ","
+    << summary.time_p90 << "," << summary.time_p99 << "," << summary.time_max << "," << summary.deadline_miss_rt << ","
+    << summary.skipped_frames << "," << summary.reinit_cnt << "\n";
+}
+
+int main(int argc, char** argv)
+{
+  spdlog::cfg::load_env_levels();
+  std::vector<fs::path> inputs;
+  fs::path output_dir;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc)
+      output_dir = argv[++i];
+    else
+      inputs.push_back(arg);
+  }
+  if (inputs.empty())
+  {
+    spdlog::error("Usage: {} run directory... [-o output directory]", argv[0]);
+    return -1;
+  }
+  if (output_dir.empty())
+    output_dir = inputs.size() == 1 ? inputs[0] : fs::current_path();
+  fs::create_directories(output_dir);
+
+  std::ofstream datasets_table(output_dir / "datasets.csv");
+  std::ofstream trackers_table(output_dir / "trackers.csv");
+  if (!datasets_table.is_open() || !trackers_table.is_open())
+  {
+    spdlog::error("Could not write the tables to {}", output_dir.string());
+    return -1;
+  }
+  datasets_table << std::setprecision(std::numeric_limits<double>::max_digits10);
+  trackers_table << std::setprecision(std::numeric_limits<double>::max_digits10);
+  writeTableHeader(datasets_table, "run,tracker");
+  writeTableHeader(trackers_table, "tracker,runs");
+
+  // one run is held at a time, only the per tracker totals are kept across runs
+  std::map<std::string, SummaryAccumulator> all_trackers;
+  std::map<std::string, size_t> tracker_runs;
+  size_t runs_cnt = 0, summaries_cnt = 0;
+  for (const auto& input : inputs)
+  {
+    for (const auto& run : findRuns(input))
+    {
+      std::map<std::string, SummaryAccumulator> run_trackers;
+      for (const auto& entry : fs::recursive_directory_iterator(run))
+      {
+        if (entry.path().filename() != "summary.yaml")
+          continue;
+        try
+        {
+          addSequenceSummary(entry.path(), run_trackers);
+          summaries_cnt++;
+        }
+        catch (const std::exception& e)
+        {
+          spdlog::warn("Skipping {}: {}", entry.path().string(), e.what());
+        }
+      }
+      for (const auto& tracker : run_trackers)
+      {
+        writeTableRow(datasets_table, run.string() + "," + tracker.first, tracker.second);
+        all_trackers[tracker.first].merge(tracker.second);
+        tracker_runs[tracker.first]++;
+      }
+      runs_cnt++;
+    }
+  }
+  for (const auto& tracker : all_trackers)
+  {
+    writeTableRow(trackers_table, tracker.first + "," + std::to_string(tracker_runs[tracker.first]), tracker.second);
+    SequenceTrackingSummary summary = tracker.second.getSummary();
+    spdlog::info("{}: {} sequences, {} frames, SR {:.4f}, overlap {:.4f}, CLE {:.2f}, time {:.4f} s (p99 {:.4f} s), RC {}",
+      tracker.first, tracker.second.getSequenceCount(), summary.frames, summary.success_rt, summary.avg_overlap,
+      summary.avg_cle, summary.avg_time, summary.time_p99, summary.reinit_cnt);
+  }
+  spdlog::info("Aggregated {} summaries of {} runs into {}", summaries_cnt, runs_cnt, output_dir.string());
+  return 0;
+}
@@ -4,16 +4,21 @@
 #include <filesystem>
 #include <fstream>
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
 #include <opencv2/opencv.hpp>
 #include <opencv2/tracking.hpp>
 #include <spdlog/spdlog.h>
 #include "spdlog/cfg/env.h"
 #include <yaml-cpp/yaml.h>
 #include "DatasetUtils.hpp"
+#include "DatasetIndex.hpp"
 #include "VideoFileReader.hpp"
 #include "ImageSequenceReader.hpp"
 
 #include "TrackerComparator.hpp"
+#include "LiveRunner.hpp"
 
 std::string createDirectoryWithTimestamp(const std::string& baseDirectory = "runs")
 {
@@ -31,6 +36,109 @@ std::string createDirectoryWithTimestamp(const std::string& baseDirectory = "run
   return directoryName;
 }
 
+void evaluateSequence(TrackerComparator& trackerComparator, const DatasetInfo& dataset_info, const std::string& results_dir)
+{
+  std::string instance_results_dir = results_dir + "/" + dataset_info.name;
+  std::filesystem::create_directories(instance_results_dir);
+
+  trackerComparator.loadDataset(dataset_info);
+  trackerComparator.setupComponents(instance_results_dir);
+  trackerComparator.runEvaluation();
+
+  trackerComparator.saveResults(instance_results_dir);
+
+  trackerComparator.reset();
+}
+
+// Runs up to workers_num sequences at once, each worker owns its comparator and a copy of the config.
+// Sequences are queued longest first, so the last ones to finish are the short ones.
+void evaluateSequencesInParallel(std::vector<DatasetInfo> dataset_infos, const std::string& results_dir, const YAML::Node& config,
+  unsigned workers_num)
+{
+  std::vector<std::pair<size_t, size_t>> queue; // (estimated length, dataset index)
+  for (size_t i = 0; i < dataset_infos.size(); i++)
+    queue.emplace_back(estimateSequenceLength(dataset_infos[i]), i);
+  std::stable_sort(queue.begin(), queue.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  workers_num = std::min<unsigned>(workers_num, queue.size());
+  spdlog::info("Evaluating {} sequences on {} workers", queue.size(), workers_num);
+
+  // yaml-cpp nodes are not safe to share between threads, clone them up front
+  std::vector<YAML::Node> worker_configs;
+  for (unsigned w = 0; w < workers_num; w++)
+    worker_configs.push_back(YAML::Clone(config));
+
+  std::atomic<size_t> next_in_queue{ 0 };
+  std::vector<std::thread> workers;
+  for (unsigned w = 0; w < workers_num; w++)
+  {
+    workers.emplace_back([&, w]() {
+      TrackerComparator trackerComparator(worker_configs[w]);
+      trackerComparator.setDisplayEnabled(false); // HighGUI can not be driven from many threads
+      size_t i;
+      while ((i = next_in_queue++) < queue.size())
+      {
+        const auto& dataset_info = dataset_infos[queue[i].second];
+        spdlog::info("Worker {} evaluating {} (~{} frames)", w, dataset_info.name, queue[i].first);
+        try
+        {
+          evaluateSequence(trackerComparator, dataset_info, results_dir);
+        }
+        catch (const std::exception& e)
+        {
+          spdlog::error("Evaluation of {} failed: {}", dataset_info.name, e.what());
+          trackerComparator.reset();
+        }
+      }
+      });
+  }
+  for (auto& worker : workers)
+    worker.join();
+}
+
+// Evaluates the tracker outputs recorded in every sequence of a run again, under the thresholds of the current config
+int replayRun(const std::string& recorded_run_dir, const YAML::Node& config)
+{
+  std::string results_dir = createDirectoryWithTimestamp();
+  TrackerComparator trackerComparator(config);
+  YAML::Emitter out;
+  out << YAML::BeginMap;
+  out << YAML::Key << "source" << YAML::Value << recorded_run_dir;
+  out << YAML::Key << "rerun" << YAML::Value << YAML::BeginSeq;
+  size_t replayed_cnt = 0, rerun_cnt = 0;
+  for (const auto& sequence_dir : getAllDirectories(recorded_run_dir))
+  {
+    if (!std::filesystem::exists(sequence_dir / "record.yaml"))
+      continue;
+    std::string instance_results_dir = results_dir + "/" + sequence_dir.filename().string();
+    std::filesystem::create_directories(instance_results_dir);
+    try
+    {
+      auto divergences = trackerComparator.replayRecording(sequence_dir.string(), instance_results_dir);
+      replayed_cnt++;
+      if (!divergences.empty())
+      {
+        out << sequence_dir.filename().string();
+        rerun_cnt++;
+      }
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::error("Replay of {} failed: {}", sequence_dir.string(), e.what());
+      out << sequence_dir.filename().string();
+      rerun_cnt++;
+    }
+  }
+  out << YAML::EndSeq;
+  out << YAML::EndMap;
+  std::ofstream replay_file(results_dir + "/replay.yaml");
+  replay_file << out.c_str();
+  std::ofstream config_file(results_dir + "/config.yaml");
+  config_file << config;
+  spdlog::info("Replayed {} sequences, {} have to be run again (listed in {}/replay.yaml)", replayed_cnt, rerun_cnt, results_dir);
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   spdlog::cfg::load_env_levels();
@@ -40,7 +148,7 @@ int main(int argc, char** argv)
   bool preview_only = false;
   if (argc < 2)
   {
-    spdlog::error("Usage: {} clip directory [-t] [tracker_for_preview_name]", argv[0]);
+    spdlog::error("Usage: {} clip directory [-t] [tracker_for_preview_name] | dataset directory -l | recorded run directory -r", argv[0]);
     return -1;
   }
   if (argc > 2 && std::string(argv[2]) == "-t")
@@ -53,6 +161,9 @@ int main(int argc, char** argv)
     preview_only = true;
   }
 
+  if (argc > 2 && std::string(argv[2]) == "-r")
+    return replayRun(argv[1], config);
+
   auto trackerComparator = std::make_unique<TrackerComparator>(config);
 
   if (preview_only)
@@ -63,20 +174,51 @@ int main(int argc, char** argv)
     return 0;
   }
 
-  auto dataset_infos = loadDatasetInfos(argv[1]);
+  std::vector<DatasetInfo> dataset_infos;
+  if (config["dataset_index"].as<bool>(false))
+  {
+    std::string index_path = config["dataset_index_path"].as<std::string>("");
+    if (index_path.empty())
+      index_path = DatasetIndex::getDefaultPath(argv[1]);
+    dataset_infos = DatasetIndex(argv[1], index_path).getDatasetInfos();
+  }
+  else
+  {
+    dataset_infos = loadDatasetInfos(argv[1]);
+  }
   std::string results_dir = createDirectoryWithTimestamp();
-  for (const auto& dataset_info : dataset_infos)
+  if (argc > 2 && std::string(argv[2]) == "-l")
   {
-    std::string instance_results_dir = results_dir + "/" + dataset_info.name;
-    std::filesystem::create_directories(instance_results_dir);
-    
-    trackerComparator->loadDataset(dataset_info);
-    trackerComparator->setupComponents(instance_results_dir);
-    trackerComparator->runEvaluation();
-
-    trackerComparator->saveResults(instance_results_dir);
-
-    trackerComparator->reset();
+    // sequences are replayed as live camera streams, see the live section of the config
+    LiveRunner liveRunner(config);
+    if (!liveRunner.setup(dataset_infos))
+      return -1;
+    liveRunner.run();
+    liveRunner.saveResults(results_dir);
+    std::ofstream fout(results_dir + "/config.yaml");
+    fout << config;
+    return 0;
+  }
+  unsigned parallel_sequences = config["parallel_sequences"].as<unsigned>(1);
+  if (parallel_sequences > 1 && dataset_infos.size() > 1)
+  {
+    evaluateSequencesInParallel(dataset_infos, results_dir, config, parallel_sequences);
+  }
+  else
+  {
+    for (const auto& dataset_info : dataset_infos)
+    {
+      // a malformed sequence is reported and skipped, the others are still evaluated
+      try
+      {
+        evaluateSequence(*trackerComparator, dataset_info, results_dir);
+      }
+      catch (const std::exception& e)
+      {
+        spdlog::error("Evaluation of {} failed: {}", dataset_info.name, e.what());
+        trackerComparator->reset();
+      }
+    }
   }
   std::ofstream fout(results_dir + "/config.yaml");
   fout << config;
@@ -16,6 +16,21 @@ double ITracker::getTrackingScore()
 {
     return -1;
 }
+void ITracker::reset()
+{
+    state = TrackerState::Ready;
+}
+
+StageTimings ITracker::getStageTimings()
+{
+    return {};
+}
+
+std::vector<cv::Rect> ITracker::getDebugBoxes()
+{
+    return {};
+}
+
 std::string ITracker::getName()
 {
     return name;
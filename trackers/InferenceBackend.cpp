@@ -0,0 +1,72 @@
+#include "InferenceBackend.hpp"
+#include "ModelRegistry.hpp"
+#include <spdlog/spdlog.h>
+
+namespace cv {
+namespace modvit {
+
+    InferenceRuntime parseInferenceRuntime(const std::string& runtime)
+    {
+        if (runtime == "onnxruntime")
+            return InferenceRuntime::OnnxRuntime;
+        if (runtime != "opencv")
+            spdlog::warn("Unknown inference runtime: {}, using opencv", runtime);
+        return InferenceRuntime::OpenCVDnn;
+    }
+
+    class DnnInferenceBackend : public InferenceBackend {
+    public:
+        DnnInferenceBackend(const std::string& model, int backend, int target)
+        {
+            if (model.size() > 5 && model.compare(model.size() - 5, 5, ".onnx") == 0)
+            {
+                // parsed straight from the mapping, the file is never copied into a read buffer. cv::dnn copies the
+                // weights into the net, the mapping is held so trackers loading the same file later do not read it again
+                mapped = ModelRegistry::instance().acquire(model);
+                net = dnn::readNetFromONNX(mapped->data(), mapped->size());
+            }
+            else
+            {
+                net = dnn::readNet(model);
+            }
+            CV_Assert(!net.empty());
+            net.setPreferableBackend(backend);
+            net.setPreferableTarget(target);
+        }
+
+        void setInput(const Mat& blob, const std::string& name) CV_OVERRIDE
+        {
+            net.setInput(blob, name);
+        }
+
+        void forward(std::vector<Mat>& outputs, const std::vector<std::string>& names) CV_OVERRIDE
+        {
+            // the net returns its own output blobs, nothing is allocated once it is set up
+            net.forward(outputs, names);
+        }
+
+    private:
+        std::shared_ptr<const MappedModel> mapped; // only for .onnx models
+        dnn::Net net;
+    };
+
+#ifdef HAVE_ONNXRUNTIME
+    Ptr<InferenceBackend> createOrtInferenceBackend(const std::string& model, int threads);
+#endif
+
+    Ptr<InferenceBackend> createInferenceBackend(InferenceRuntime runtime, const std::string& model, int backend, int target,
+        int threads)
+    {
+        if (runtime == InferenceRuntime::OnnxRuntime)
+        {
+#ifdef HAVE_ONNXRUNTIME
+            return createOrtInferenceBackend(model, threads);
+#else
+            CV_Error(Error::StsNotImplemented, "the trackers library was built without ONNX Runtime");
+#endif
+        }
+        return makePtr<DnnInferenceBackend>(model, backend, target);
+    }
+
+}
+}
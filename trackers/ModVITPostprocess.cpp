@@ -0,0 +1,111 @@
+#include "ModVITPostprocess.hpp"
+
+namespace cv {
+namespace modvit {
+
+    double calculate_overlap(const Rect& bb1, const Rect& bb2)
+    {
+        int intersectionArea = (bb1 & bb2).area();
+        int unionArea = bb1.area() + bb2.area() - intersectionArea;
+        return static_cast<double>(intersectionArea) / unionArea;
+    }
+
+    static Mat hann1d(int sz, bool centered = true) {
+        Mat hanningWindow(sz, 1, CV_32FC1);
+        float* data = hanningWindow.ptr<float>(0);
+
+        if (centered) {
+            for (int i = 0; i < sz; i++) {
+                float val = 0.5f * (1.f - std::cos(static_cast<float>(2 * M_PI / (sz + 1)) * (i + 1)));
+                data[i] = val;
+            }
+        }
+        else {
+            int half_sz = sz / 2;
+            for (int i = 0; i <= half_sz; i++) {
+                float val = 0.5f * (1.f + std::cos(static_cast<float>(2 * M_PI / (sz + 2)) * i));
+                data[i] = val;
+                data[sz - 1 - i] = val;
+            }
+        }
+
+        return hanningWindow;
+    }
+
+    Mat hann2d(Size size, bool centered) {
+        int rows = size.height;
+        int cols = size.width;
+
+        Mat hanningWindowRows = hann1d(rows, centered);
+        Mat hanningWindowCols = hann1d(cols, centered);
+
+        Mat hanningWindow = hanningWindowRows * hanningWindowCols.t();
+
+        return hanningWindow;
+    }
+
+    Rect returnfromcrop(float x, float y, float w, float h, Rect resLast)
+    {
+        int cropWindowWH = 4 * cvFloor(sqrt(resLast.width * resLast.height));
+        int x0 = resLast.x + (resLast.width - cropWindowWH) / 2;
+        int y0 = resLast.y + (resLast.height - cropWindowWH) / 2;
+        Rect finalRes;
+        finalRes.x = cvFloor(x * cropWindowWH + x0);
+        finalRes.y = cvFloor(y * cropWindowWH + y0);
+        finalRes.width = cvFloor(w * cropWindowWH);
+        finalRes.height = cvFloor(h * cropWindowWH);
+        return finalRes;
+    }
+
+    void findTopCandidates(const Mat& confMap, const Mat& sizeMap, const Mat& offsetMap, const Rect& rectLast, int count,
+        Mat& scratch, std::vector<Rect>& rects, std::vector<double>& scores)
+    {
+        rects.clear();
+        scores.clear();
+        confMap.copyTo(scratch);
+
+        for (int i = 0; i < count; i++)
+        {
+            double maxVal;
+            Point maxLoc;
+            minMaxLoc(scratch, nullptr, &maxVal, nullptr, &maxLoc);
+
+            float cx = (maxLoc.x + offsetMap.at<float>(0, maxLoc.y, maxLoc.x)) / 16;
+            float cy = (maxLoc.y + offsetMap.at<float>(1, maxLoc.y, maxLoc.x)) / 16;
+            float w = sizeMap.at<float>(0, maxLoc.y, maxLoc.x);
+            float h = sizeMap.at<float>(1, maxLoc.y, maxLoc.x);
+
+            rects.push_back(returnfromcrop(cx - w / 2, cy - h / 2, w, h, rectLast));
+            scores.push_back(static_cast<float>(maxVal));
+            scratch.at<float>(maxLoc.y, maxLoc.x) = 0;
+        }
+    }
+
+    int fuseCandidates(const std::vector<Rect>& rects, const std::vector<double>& scores)
+    {
+        int highestScoreIndex = 0;
+
+        // simillar confs of the best two candidates
+        if (scores[0] < 1.2 * scores[1]) {
+            // postprocessed scores
+            std::vector<double> candidatesScores;
+            // take first 3 highest scores and calculate their overlaps with other ones
+            for (int i = 0; i < 3; i++)
+            {
+                double candidateScore = 0;
+                for (int j = 0; j < (int)rects.size(); j++)
+                {
+                    candidateScore += calculate_overlap(rects[i], rects[j]) * scores[j];
+                }
+                candidateScore *= scores[i];
+                candidatesScores.push_back(candidateScore);
+            }
+
+            auto maxCandidateScoreIter = std::max_element(candidatesScores.begin(), candidatesScores.end());
+            highestScoreIndex = std::distance(candidatesScores.begin(), maxCandidateScoreIter);
+        }
+        return highestScoreIndex;
+    }
+
+}
+}
@@ -0,0 +1,66 @@
+#include "ModVITPreprocess.hpp"
+
+namespace cv {
+namespace modvit {
+
+    NormalizationConstants::NormalizationConstants(const Scalar& meanvalue, const Scalar& stdvalue)
+    {
+        // same rounding as the Mat operations of the reference implementation
+        scale = static_cast<float>(1.0 / 255);
+        for (int c = 0; c < 3; c++)
+        {
+            mean[c] = static_cast<float>(meanvalue[c]);
+            std[c] = static_cast<float>(stdvalue[c]);
+        }
+    }
+
+    void normalizeToBlob(const Mat& patch, Mat& blob, const NormalizationConstants& constants)
+    {
+        CV_Assert(patch.type() == CV_8UC3);
+        const int rows = patch.rows;
+        const int cols = patch.cols;
+        const int shape[] = { 1, 3, rows, cols };
+        blob.create(4, shape, CV_32F);
+
+        float* planes[3] = { blob.ptr<float>(0, 0), blob.ptr<float>(0, 1), blob.ptr<float>(0, 2) };
+        for (int y = 0; y < rows; y++)
+        {
+            const uchar* src = patch.ptr<uchar>(y);
+            for (int c = 0; c < 3; c++)
+            {
+                float* dst = planes[c] + y * cols;
+                const float scale = constants.scale;
+                const float mean = constants.mean[c];
+                const float std = constants.std[c];
+                // kept as separate multiply, subtract and divide to match the reference rounding,
+                // the file is compiled without floating point contraction
+                for (int x = 0; x < cols; x++)
+                {
+                    float value = static_cast<float>(src[3 * x + c]) * scale;
+                    value = value - mean;
+                    dst[x] = value / std;
+                }
+            }
+        }
+    }
+
+    void cropResizedPatch(const Mat& frame, Mat& patch, const Rect& box, int factor, Size size)
+    {
+        int cropSz = cvCeil(sqrt(box.width * box.height) * factor);
+        int x1 = box.x + (box.width - cropSz) / 2;
+        int y1 = box.y + (box.height - cropSz) / 2;
+
+        // destination to source mapping with the pixel center convention of resize
+        double sx = static_cast<double>(cropSz) / size.width;
+        double sy = static_cast<double>(cropSz) / size.height;
+        Matx23d dstToSrc(sx, 0, x1 + 0.5 * sx - 0.5,
+                         0, sy, y1 + 0.5 * sy - 0.5);
+        // the original crop padded one pixel too many at the right and bottom edges, dropping the last column
+        // or row of the frame whenever the window reached it, kept so the tracker output does not change
+        int cols = x1 + cropSz >= frame.cols ? frame.cols - 1 : frame.cols;
+        int rows = y1 + cropSz >= frame.rows ? frame.rows - 1 : frame.rows;
+        warpAffine(frame(Rect(0, 0, cols, rows)), patch, dstToSrc, size, INTER_LINEAR | WARP_INVERSE_MAP, BORDER_CONSTANT, Scalar());
+    }
+
+}
+}
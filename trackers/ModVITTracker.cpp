@@ -1,11 +1,27 @@
 #include "TrackerModVIT.hpp"
 #include "ModVITTracker.hpp"
 
-ModVITTracker::ModVITTracker(double score_thresh) :score_thresh(score_thresh)
+ModVITTracker::ModVITTracker(double score_thresh) :ModVITTracker(score_thresh, ModelSpec())
 {
-    name = "ModVIT";
+}
+
+ModVITTracker::ModVITTracker(double score_thresh, const ModelSpec& model, const std::string& name)
+    :score_thresh(score_thresh)
+{
+    this->name = name;
     cv::TrackerModVIT::Params params;
-    params.net = "nn_models/vit.onnx";
+    params.net = model.path;
+    params.backend = model.backend;
+    params.target = model.getEffectiveTarget();
+    params.runtime = cv::modvit::parseInferenceRuntime(model.runtime);
+    params.threads = model.threads;
+    tracker = cv::TrackerModVIT::create(params);
+}
+
+ModVITTracker::ModVITTracker(double score_thresh, const cv::TrackerModVIT::Params& params, const std::string& name)
+    :score_thresh(score_thresh)
+{
+    this->name = name;
     tracker = cv::TrackerModVIT::create(params);
 }
 ModVITTracker::~ModVITTracker() {}
@@ -28,4 +44,15 @@ bool ModVITTracker::update(const cv::Mat& frame, cv::Rect& roi)
 double ModVITTracker::getTrackingScore()
 {
     return tracker.dynamicCast<cv::TrackerModVIT>()->getTrackingScore();
+}
+
+StageTimings ModVITTracker::getStageTimings()
+{
+    auto timings = tracker.dynamicCast<cv::TrackerModVIT>()->getStageTimings();
+    return { {"Crop", timings.crop}, {"Preprocess", timings.preprocess}, {"Inference", timings.inference}, {"Postprocess", timings.postprocess} };
+}
+
+std::vector<cv::Rect> ModVITTracker::getDebugBoxes()
+{
+    return tracker.dynamicCast<cv::TrackerModVIT>()->getCandidates();
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "ModelRegistry.hpp"
+#include <set>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+namespace fs = std::filesystem;
+
+static uint64_t fnv1a(const unsigned char* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+MappedModel::MappedModel(const std::string& path) : path(path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Could not open the model file: " + path);
+    length = fs::file_size(path);
+    modification_time = fs::last_write_time(path);
+    address = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps the file referenced
+    if (address == MAP_FAILED)
+    {
+        address = nullptr;
+        throw std::runtime_error("Could not map the model file: " + path);
+    }
+    // weights are read sequentially by the parsers
+    madvise(address, length, MADV_SEQUENTIAL);
+}
+
+uint64_t MappedModel::getHash() const
+{
+    std::call_once(hash_once, [this]() { hash = fnv1a(static_cast<const unsigned char*>(address), length); });
+    return hash;
+}
+
+MappedModel::~MappedModel()
+{
+    if (address)
+        munmap(address, length);
+}
+
+ModelRegistry& ModelRegistry::instance()
+{
+    static ModelRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<const MappedModel> ModelRegistry::acquire(const std::string& path)
+{
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(path, ec);
+    std::string key = ec ? path : canonical.string();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = by_path.find(key);
+    if (it != by_path.end())
+    {
+        // revalidate, the file may have been replaced since it was mapped
+        auto model = it->second.lock();
+        if (model && fs::last_write_time(key, ec) == model->getModificationTime() && !ec && fs::file_size(key, ec) == model->size())
+        {
+            shared_hits++;
+            return model;
+        }
+    }
+
+    auto model = std::make_shared<const MappedModel>(key);
+    for (const auto& [other_path, entry] : by_path)
+    {
+        // only files of equal size can have the same content, others are never hashed
+        auto existing = entry.lock();
+        if (!existing || other_path == key || existing->size() != model->size() || existing->getHash() != model->getHash())
+            continue;
+        spdlog::debug("Model {} has the same content as {}, sharing its mapping", key, existing->getPath());
+        by_path[key] = existing;
+        shared_hits++;
+        return existing;
+    }
+    spdlog::debug("Mapped model {} ({} bytes)", key, model->size());
+    by_path[key] = model;
+    return model;
+}
+
+ModelRegistryStats ModelRegistry::getStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ModelRegistryStats stats;
+    stats.shared_hits = shared_hits;
+    std::set<const MappedModel*> counted; // paths sharing a mapping count once
+    for (const auto& [path, entry] : by_path)
+    {
+        auto model = entry.lock();
+        if (model && counted.insert(model.get()).second)
+        {
+            stats.models++;
+            stats.mapped_bytes += model->size();
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,67 @@
+#include "ModelSpec.hpp"
+#include <spdlog/spdlog.h>
+
+int ModelSpec::getEffectiveTarget() const
+{
+    if (precision != ModelPrecision::FP16)
+        return target;
+    switch (target)
+    {
+    case cv::dnn::DNN_TARGET_CPU:
+        return cv::dnn::DNN_TARGET_CPU_FP16;
+    case cv::dnn::DNN_TARGET_OPENCL:
+        return cv::dnn::DNN_TARGET_OPENCL_FP16;
+    case cv::dnn::DNN_TARGET_CUDA:
+        return cv::dnn::DNN_TARGET_CUDA_FP16;
+    default:
+        return target;
+    }
+}
+
+int parseDnnBackend(const std::string& backend)
+{
+    if (backend == "opencv")
+        return cv::dnn::DNN_BACKEND_OPENCV;
+    if (backend == "openvino")
+        return cv::dnn::DNN_BACKEND_INFERENCE_ENGINE;
+    if (backend == "cuda")
+        return cv::dnn::DNN_BACKEND_CUDA;
+    if (backend != "default")
+        spdlog::warn("Unknown dnn backend: {}, using default", backend);
+    return cv::dnn::DNN_BACKEND_DEFAULT;
+}
+
+int parseDnnTarget(const std::string& target)
+{
+    if (target == "opencl")
+        return cv::dnn::DNN_TARGET_OPENCL;
+    if (target == "cuda")
+        return cv::dnn::DNN_TARGET_CUDA;
+    if (target != "cpu")
+        spdlog::warn("Unknown dnn target: {}, using cpu", target);
+    return cv::dnn::DNN_TARGET_CPU;
+}
+
+ModelPrecision parseModelPrecision(const std::string& precision)
+{
+    if (precision == "fp16")
+        return ModelPrecision::FP16;
+    if (precision == "int8")
+        return ModelPrecision::INT8;
+    if (precision != "fp32")
+        spdlog::warn("Unknown model precision: {}, using fp32", precision);
+    return ModelPrecision::FP32;
+}
+
+std::string precisionToString(ModelPrecision precision)
+{
+    switch (precision)
+    {
+    case ModelPrecision::FP16:
+        return "fp16";
+    case ModelPrecision::INT8:
+        return "int8";
+    default:
+        return "fp32";
+    }
+}
@@ -0,0 +1,167 @@
+#include "InferenceBackend.hpp"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <onnxruntime_cxx_api.h>
+#include "ModelRegistry.hpp"
+
+namespace cv {
+namespace modvit {
+
+    static Ort::Env& sharedEnv()
+    {
+        static Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "TrackerModVIT");
+        return env;
+    }
+
+    // Session together with the mapping it was created from, the session may keep pointing into it
+    struct MappedSession {
+        std::shared_ptr<const MappedModel> mapped;
+        Ort::Session session;
+    };
+
+    // Sessions are shared by every backend running the same model content with the same options,
+    // so the weights are loaded once per process. Session::Run is safe to call concurrently.
+    static std::shared_ptr<Ort::Session> acquireSession(const std::string& model, int threads)
+    {
+        static std::mutex mutex;
+        // the registry maps identical contents once, so the mapping identifies the content
+        static std::map<std::pair<const MappedModel*, int>, std::weak_ptr<MappedSession>> sessions;
+
+        auto mapped = ModelRegistry::instance().acquire(model);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = sessions[{ mapped.get(), threads }];
+        if (auto existing = entry.lock())
+            return std::shared_ptr<Ort::Session>(existing, &existing->session);
+
+        Ort::SessionOptions options;
+        options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+        if (threads > 0)
+            options.SetIntraOpNumThreads(threads);
+        // weights are used in place from the mapping instead of being copied, which ONNX Runtime only
+        // supports for models in the ORT format, .onnx models are still copied into the session
+        options.AddConfigEntry("session.use_ort_model_bytes_directly", "1");
+        options.AddConfigEntry("session.use_ort_model_bytes_for_initializers", "1");
+        auto created = std::make_shared<MappedSession>(MappedSession{ mapped, Ort::Session(sharedEnv(), mapped->data(), mapped->size(), options) });
+        entry = created;
+        return std::shared_ptr<Ort::Session>(created, &created->session);
+    }
+
+    // ONNX Runtime on the CPU execution provider. Inputs and outputs live in Mats allocated once,
+    // the runtime reads and writes them in place through tensors wrapping their memory.
+    class OrtInferenceBackend : public InferenceBackend {
+    public:
+        OrtInferenceBackend(const std::string& model, int threads)
+            : memoryInfo(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault)), session(acquireSession(model, threads))
+        {
+            // outputs with static shapes are allocated here, so no forward runs the model an extra time
+            Ort::AllocatorWithDefaultOptions allocator;
+            for (size_t i = 0; i < session->GetOutputCount(); i++)
+            {
+                std::vector<int64_t> shape = session->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+                if (std::any_of(shape.begin(), shape.end(), [](int64_t size) { return size < 0; }))
+                    continue;
+                allocateOutput(session->GetOutputNameAllocated(i, allocator).get(), shape);
+            }
+        }
+
+        void setInput(const Mat& blob, const std::string& name) CV_OVERRIDE
+        {
+            CV_Assert(blob.type() == CV_32F && blob.isContinuous());
+            Tensor& input = inputTensors[name];
+            bool reshaped = !input.value || input.data.size != blob.size;
+            blob.copyTo(input.data); // no allocation while the shape stays the same
+            if (reshaped)
+                input.value = wrap(input.data);
+        }
+
+        void forward(std::vector<Mat>& outputs, const std::vector<std::string>& names) CV_OVERRIDE
+        {
+            inputNames.clear();
+            inputValues.clear();
+            for (auto& [name, input] : inputTensors)
+            {
+                inputNames.push_back(name.c_str());
+                inputValues.push_back(std::move(input.value));
+            }
+            outputNames.clear();
+            for (const auto& name : names)
+                outputNames.push_back(name.c_str());
+
+            prepareOutputs(names);
+            std::vector<Ort::Value> outputValues;
+            outputValues.reserve(names.size());
+            for (const auto& name : names)
+                outputValues.push_back(std::move(outputTensors[name].value));
+
+            session->Run(runOptions, inputNames.data(), inputValues.data(), inputValues.size(),
+                outputNames.data(), outputValues.data(), outputValues.size());
+
+            // hand the wrappers back, they keep pointing to the same buffers
+            size_t i = 0;
+            for (auto& [name, input] : inputTensors)
+                input.value = std::move(inputValues[i++]);
+            outputs.resize(names.size());
+            for (size_t j = 0; j < names.size(); j++)
+            {
+                Tensor& output = outputTensors[names[j]];
+                output.value = std::move(outputValues[j]);
+                outputs[j] = output.data;
+            }
+        }
+
+    private:
+        struct Tensor {
+            Mat data;
+            Ort::Value value{ nullptr };
+        };
+
+        Ort::Value wrap(Mat& data)
+        {
+            std::vector<int64_t> shape(data.size.p, data.size.p + data.dims);
+            return Ort::Value::CreateTensor<float>(memoryInfo, data.ptr<float>(), data.total(), shape.data(), shape.size());
+        }
+
+        void allocateOutput(const std::string& name, const std::vector<int64_t>& shape)
+        {
+            std::vector<int> sizes(shape.begin(), shape.end());
+            Tensor& output = outputTensors[name];
+            output.data.create(static_cast<int>(sizes.size()), sizes.data(), CV_32F);
+            output.value = wrap(output.data);
+        }
+
+        // outputs with dynamic dimensions are only known after one run with runtime allocated outputs,
+        // which makes the first forward of such a model about twice as slow
+        void prepareOutputs(const std::vector<std::string>& names)
+        {
+            bool allocated = true;
+            for (const auto& name : names)
+                allocated = allocated && outputTensors.count(name) > 0;
+            if (allocated)
+                return;
+
+            std::vector<Ort::Value> results = session->Run(runOptions, inputNames.data(), inputValues.data(), inputValues.size(),
+                outputNames.data(), outputNames.size());
+            for (size_t i = 0; i < names.size(); i++)
+                allocateOutput(names[i], results[i].GetTensorTypeAndShapeInfo().GetShape());
+        }
+
+        Ort::MemoryInfo memoryInfo;
+        std::shared_ptr<Ort::Session> session; // shared with other backends, the buffers below are not
+        Ort::RunOptions runOptions;
+        std::map<std::string, Tensor> inputTensors;
+        std::map<std::string, Tensor> outputTensors;
+        // per call scratch, kept to avoid reallocating
+        std::vector<const char*> inputNames;
+        std::vector<Ort::Value> inputValues;
+        std::vector<const char*> outputNames;
+    };
+
+    Ptr<InferenceBackend> createOrtInferenceBackend(const std::string& model, int threads)
+    {
+        return makePtr<OrtInferenceBackend>(model, threads);
+    }
+
+}
+}
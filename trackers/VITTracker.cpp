@@ -1,10 +1,20 @@
 #include "VITTracker.hpp"
+#include <spdlog/spdlog.h>
 
-VITTracker::VITTracker(double score_thresh) :score_thresh(score_thresh)
+VITTracker::VITTracker(double score_thresh) :VITTracker(score_thresh, ModelSpec())
 {
-    name = "VIT";
+}
+
+VITTracker::VITTracker(double score_thresh, const ModelSpec& model, const std::string& name)
+    :score_thresh(score_thresh)
+{
+    this->name = name;
     cv::TrackerVit::Params params;
-    params.net = "nn_models/vit.onnx";
+    params.net = model.path;
+    params.backend = model.backend;
+    params.target = model.getEffectiveTarget();
+    if (model.runtime != "opencv")
+        spdlog::warn("{} supports only the opencv runtime, ignoring {}", name, model.runtime);
     tracker = cv::TrackerVit::create(params);
 }
 VITTracker::~VITTracker() {}
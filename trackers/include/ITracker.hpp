@@ -12,6 +12,9 @@ enum class TrackerState
 };
 std::string stateToString(TrackerState state);
 
+// Named stages of a single update with their durations in seconds
+using StageTimings = std::vector<std::pair<std::string, double>>;
+
 
 class ITracker
 {
@@ -22,6 +25,12 @@ public:
     virtual void init(const cv::Mat& frame, const cv::Rect& roi) = 0;
     virtual bool update(const cv::Mat& frame, cv::Rect& roi) = 0;
     virtual double getTrackingScore();
+    // Prepares the tracker for a new sequence, keeping the loaded models. init is still required.
+    virtual void reset();
+    // Optional instrumentation, breakdown of the last update, empty when the tracker does not provide one
+    virtual StageTimings getStageTimings();
+    // Optional intermediate boxes of the last update, drawn only in debug mode
+    virtual std::vector<cv::Rect> getDebugBoxes();
     std::string getName();
     TrackerState getState();
     void setState(TrackerState s);
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace cv {
+namespace modvit {
+
+    enum class InferenceRuntime {
+        OpenCVDnn,
+        OnnxRuntime // CPU execution provider, only when built with ONNX Runtime
+    };
+
+    InferenceRuntime parseInferenceRuntime(const std::string& runtime);
+
+    // Runs one onnx graph with named inputs and outputs. Inputs stay set until overwritten, so inputs
+    // constant for a sequence (the template) are only set once per init.
+    class InferenceBackend {
+    public:
+        virtual ~InferenceBackend() {}
+        virtual void setInput(const Mat& blob, const std::string& name) = 0;
+        // Output Mats point to buffers owned by the backend, valid and writable until the next forward
+        virtual void forward(std::vector<Mat>& outputs, const std::vector<std::string>& names) = 0;
+    };
+
+    // threads is only used by ONNX Runtime, 0 leaves the choice to the runtime
+    Ptr<InferenceBackend> createInferenceBackend(InferenceRuntime runtime, const std::string& model, int backend, int target,
+        int threads);
+
+}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+namespace cv {
+namespace modvit {
+
+    // Hann window of the given size, centered variant excludes the zero endpoints
+    Mat hann2d(Size size, bool centered = true);
+
+    double calculate_overlap(const Rect& bb1, const Rect& bb2);
+
+    // Maps a box in normalized search crop coordinates back to the frame, the crop is centered on resLast
+    Rect returnfromcrop(float x, float y, float w, float h, Rect resLast);
+
+    // Takes the count highest scores of confMap, with their boxes decoded from sizeMap and offsetMap
+    // (2x16x16 each) relative to the search crop around rectLast. scratch is reused between calls.
+    void findTopCandidates(const Mat& confMap, const Mat& sizeMap, const Mat& offsetMap, const Rect& rectLast, int count,
+        Mat& scratch, std::vector<Rect>& rects, std::vector<double>& scores);
+
+    // Index of the chosen candidate. When the best two scores are close, the best three are re-ranked
+    // by their score weighted overlap with all candidates.
+    int fuseCandidates(const std::vector<Rect>& rects, const std::vector<double>& scores);
+
+}
+}
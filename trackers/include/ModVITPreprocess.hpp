@@ -0,0 +1,28 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+
+namespace cv {
+namespace modvit {
+
+    // Per channel normalization of the network input, computed once per TrackerModVIT::Params
+    struct NormalizationConstants {
+        float scale; // 1 / 255, applied before mean and std
+        float mean[3];
+        float std[3];
+
+        NormalizationConstants(const Scalar& meanvalue, const Scalar& stdvalue);
+    };
+
+    // Converts an 8 bit 3 channel patch into a normalized 1x3xHxW float blob in a single pass.
+    // The blob is only allocated when its shape changes. Produces the same values, bit for bit, as
+    // blobFromImage followed by division by 255, mean subtraction and division by std.
+    void normalizeToBlob(const Mat& patch, Mat& blob, const NormalizationConstants& constants);
+
+    // Samples the square window of side sqrt(w * h) * factor centered on box straight from the frame
+    // into a patch of the given size. Pixels outside the frame are zero. Matches cropping, padding with
+    // a constant border and resizing up to interpolation rounding (see test_modvit_preprocess), without
+    // copying the frame or the crop.
+    void cropResizedPatch(const Mat& frame, Mat& patch, const Rect& box, int factor, Size size);
+
+}
+}
@@ -1,14 +1,20 @@
 #pragma once
 #include "ITracker.hpp"
+#include "TrackerModVIT.hpp"
+#include "ModelSpec.hpp"
 
 class ModVITTracker : public ITracker
 {
 public:
     ModVITTracker(double score_thresh);
+    ModVITTracker(double score_thresh, const ModelSpec& model, const std::string& name = "ModVIT");
+    ModVITTracker(double score_thresh, const cv::TrackerModVIT::Params& params, const std::string& name);
     ~ModVITTracker();
     virtual void init(const cv::Mat &frame, const cv::Rect &roi);
     virtual bool update(const cv::Mat &frame, cv::Rect &roi);
     virtual double getTrackingScore();
+    virtual StageTimings getStageTimings();
+    virtual std::vector<cv::Rect> getDebugBoxes();
 private:
     double score_thresh;
 };
\ No newline at end of file
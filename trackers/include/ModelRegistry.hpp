@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Read-only memory mapping of a model file. Mappings of the same file share physical pages
+// between all instances in the process and between processes, through the page cache.
+// Model files have to be replaced by rename, rewriting one in place changes the live mapping.
+class MappedModel
+{
+public:
+    explicit MappedModel(const std::string& path);
+    ~MappedModel();
+    MappedModel(const MappedModel&) = delete;
+    MappedModel& operator=(const MappedModel&) = delete;
+
+    const char* data() const { return static_cast<const char*>(address); }
+    size_t size() const { return length; }
+    const std::string& getPath() const { return path; }
+    // FNV-1a of the content, computed on first use
+    uint64_t getHash() const;
+    std::filesystem::file_time_type getModificationTime() const { return modification_time; }
+
+private:
+    std::string path;
+    void* address = nullptr;
+    size_t length = 0;
+    mutable std::once_flag hash_once;
+    mutable uint64_t hash = 0;
+    std::filesystem::file_time_type modification_time;
+};
+
+struct ModelRegistryStats
+{
+    size_t models = 0;       // distinct model contents currently mapped
+    size_t mapped_bytes = 0;
+    size_t shared_hits = 0;  // acquire calls served by an existing mapping
+};
+
+// Process wide registry of mapped models keyed by path. A model stays mapped as long as someone holds it,
+// inference backends hold theirs for their whole lifetime. Files changed on disk are mapped again, identical
+// files under different paths share one mapping, contents are only hashed when sizes collide.
+class ModelRegistry
+{
+public:
+    static ModelRegistry& instance();
+
+    // Throws std::runtime_error when the file can not be mapped
+    std::shared_ptr<const MappedModel> acquire(const std::string& path);
+    ModelRegistryStats getStats();
+
+private:
+    ModelRegistry() = default;
+
+    std::mutex mutex;
+    std::map<std::string, std::weak_ptr<const MappedModel>> by_path;
+    size_t shared_hits = 0;
+};
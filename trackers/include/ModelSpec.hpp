@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include <opencv2/dnn.hpp>
+
+enum class ModelPrecision
+{
+    FP32,
+    FP16, // computed in half precision on targets supporting it
+    INT8  // model file is already quantized, see python-utils/quantize_vit_model.py
+};
+
+// Which model file a dnn based tracker loads and where it runs
+struct ModelSpec
+{
+    std::string path = "nn_models/vit.onnx";
+    int backend = cv::dnn::DNN_BACKEND_DEFAULT;
+    int target = cv::dnn::DNN_TARGET_CPU;
+    ModelPrecision precision = ModelPrecision::FP32;
+    std::string runtime = "opencv"; // opencv or onnxruntime, only ModVIT supports onnxruntime
+    int threads = 0;                // onnxruntime intra op threads, 0 lets the runtime decide
+
+    // target with the precision applied, FP16 picks the half precision variant of the target
+    int getEffectiveTarget() const;
+};
+
+int parseDnnBackend(const std::string& backend);
+int parseDnnTarget(const std::string& target);
+ModelPrecision parseModelPrecision(const std::string& precision);
+std::string precisionToString(ModelPrecision precision);
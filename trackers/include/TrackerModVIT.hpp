@@ -1,5 +1,6 @@
 #pragma once
 #include <opencv2/opencv.hpp>
+#include "InferenceBackend.hpp"
 
 namespace cv {
 
@@ -12,15 +13,35 @@ namespace cv {
             Scalar stdvalue;
             int backend;
             int target;
+            // backend and target only apply to the OpenCV dnn runtime, threads only to ONNX Runtime
+            modvit::InferenceRuntime runtime;
+            int threads;
+            // Optional split of net, set both to encode the template once per init and only run
+            // the search branch on update. The search net takes the template encoder outputs
+            // as inputs of the same names.
+            std::string templateNet;
+            std::string searchNet;
+            std::vector<String> templateFeatures;
 
             Params();
         };
 
+        // Duration of each stage of the last update, in seconds
+        struct StageTimings {
+            double crop = 0;
+            double preprocess = 0;
+            double inference = 0;
+            double postprocess = 0;
+        };
+
         TrackerModVIT();
         virtual ~TrackerModVIT();
 
         static Ptr<TrackerModVIT> create(const Params& parameters = Params());
         virtual float getTrackingScore() = 0;
+        virtual StageTimings getStageTimings() = 0;
+        // Top candidates considered in the last update, for debug drawing
+        virtual std::vector<Rect> getCandidates() = 0;
 
     protected:
         virtual void init(InputArray image, const Rect& boundingBox) CV_OVERRIDE = 0;
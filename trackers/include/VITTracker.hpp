@@ -1,10 +1,12 @@
 #pragma once
 #include "ITracker.hpp"
+#include "ModelSpec.hpp"
 
 class VITTracker : public ITracker
 {
 public:
     VITTracker(double score_thresh);
+    VITTracker(double score_thresh, const ModelSpec& model, const std::string& name = "VIT");
     ~VITTracker();
     virtual void init(const cv::Mat &frame, const cv::Rect &roi);
     virtual bool update(const cv::Mat &frame, cv::Rect &roi);
@@ -0,0 +1,121 @@
+#include "AsyncVideoWriter.hpp"
+#include <spdlog/spdlog.h>
+
+QueueFullPolicy parseQueueFullPolicy(const std::string& policy)
+{
+    if (policy == "drop")
+        return QueueFullPolicy::Drop;
+    if (policy != "block")
+        spdlog::warn("Unknown queue full policy: {}, blocking", policy);
+    return QueueFullPolicy::Block;
+}
+
+AsyncVideoWriter::AsyncVideoWriter(const AsyncVideoWriterArgs& args) : args(args)
+{
+    writer_thread = std::thread(&AsyncVideoWriter::writerLoop, this);
+}
+
+AsyncVideoWriter::~AsyncVideoWriter()
+{
+    finish();
+}
+
+bool AsyncVideoWriter::write(const cv::Mat& frame)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (finishing)
+            return false;
+        if (queue.size() >= args.queue_size)
+        {
+            if (args.full_policy == QueueFullPolicy::Drop)
+            {
+                stats.frames_dropped++;
+                return false;
+            }
+            slot_free.wait(lock, [this] { return queue.size() < args.queue_size || finishing; });
+        }
+        queue.push_back(frame);
+    }
+    frame_ready.notify_one();
+    return true;
+}
+
+void AsyncVideoWriter::finish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishing = true;
+    }
+    frame_ready.notify_all();
+    slot_free.notify_all();
+    if (writer_thread.joinable())
+        writer_thread.join();
+    writer.release();
+}
+
+VideoWriterStats AsyncVideoWriter::getStats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void AsyncVideoWriter::writerLoop()
+{
+    while (true)
+    {
+        cv::Mat frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            frame_ready.wait(lock, [this] { return !queue.empty() || finishing; });
+            if (queue.empty())
+                break;
+            frame = queue.front();
+            queue.pop_front();
+        }
+        slot_free.notify_one();
+        encode(frame);
+    }
+}
+
+void AsyncVideoWriter::encode(const cv::Mat& frame)
+{
+    if (open_failed)
+        return;
+    if (!writer.isOpened())
+    {
+        open_failed = true;
+        if (args.frame_size.empty())
+            args.frame_size = frame.size();
+        if (args.codec.size() != 4)
+        {
+            spdlog::error("Video codec must be a fourcc code, got: {}", args.codec);
+            return;
+        }
+        int fourcc = cv::VideoWriter::fourcc(args.codec[0], args.codec[1], args.codec[2], args.codec[3]);
+        if (!writer.open(args.path, fourcc, args.fps, args.frame_size, frame.channels() == 3))
+        {
+            spdlog::error("Could not open video writer: {}", args.path);
+            return;
+        }
+        open_failed = false;
+        spdlog::debug("Writing {}x{} video at {} fps to {}", args.frame_size.width, args.frame_size.height, args.fps, args.path);
+    }
+
+    bool resized = frame.size() != args.frame_size;
+    if (resized)
+    {
+        cv::Mat scaled;
+        cv::resize(frame, scaled, args.frame_size);
+        writer.write(scaled);
+    }
+    else
+    {
+        writer.write(frame);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.frames_written++;
+    if (resized)
+        stats.frames_resized++;
+}
@@ -0,0 +1,345 @@
+#include "CachedVideoReader.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+#include "DatasetIndex.hpp"
+#include "MappedFile.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+const char cache_magic[8] = { 'T', 'C', 'F', 'R', 'A', 'M', 'E', 'S' };
+const uint32_t cache_version = 1;
+const size_t block_alignment = 64; // frame data starts on a cache line
+
+// Padded to block_alignment in the file
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    double fps;
+    uint64_t frame_count; // 0 until the entry is complete
+};
+
+struct FrameHeader
+{
+    int32_t rows;
+    int32_t cols;
+    int32_t type;
+    int32_t reserved;
+    uint64_t data_bytes;
+};
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + block_alignment - 1) / block_alignment * block_alignment;
+}
+
+uint64_t fnv1a(const std::string& text)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}
+
+CachedVideoReader::CachedVideoReader(const std::string& media_path, SourceFactory source_factory, const FrameCacheArgs& args)
+    : source_factory(std::move(source_factory)), args(args)
+{
+    std::error_code ec;
+    fs::create_directories(args.directory, ec);
+    entry_path = (fs::path(args.directory) / entryName(media_path)).string();
+
+    if (openEntry())
+    {
+        spdlog::debug("Frame cache hit for {}: {} frames", media_path, frame_offsets.size());
+        // the modification time orders entries for eviction
+        fs::last_write_time(entry_path, fs::file_time_type::clock::now(), ec);
+        return;
+    }
+    spdlog::debug("Frame cache miss for {}", media_path);
+    source = this->source_factory();
+    fps = source->getFps();
+    done = source->isDone();
+    beginWrite();
+}
+
+CachedVideoReader::~CachedVideoReader()
+{
+    abandonWrite();
+}
+
+std::string CachedVideoReader::entryName(const std::string& media_path)
+{
+    std::error_code ec;
+    fs::path absolute = fs::absolute(media_path, ec);
+    FileStamp stamp = getFileStamp(media_path);
+    char name[64];
+    std::snprintf(name, sizeof(name), "%016llx_%llx_%llx.frames", static_cast<unsigned long long>(fnv1a(absolute.string())),
+        static_cast<unsigned long long>(stamp.mtime), static_cast<unsigned long long>(stamp.size));
+    return name;
+}
+
+bool CachedVideoReader::openEntry()
+{
+    // writes to a served frame are copied on write and never reach the file
+    auto entry = std::make_shared<MappedFile>(entry_path, true);
+    uint64_t length = entry->view().size();
+    if (length < alignUp(sizeof(FileHeader)))
+        return false;
+
+    FileHeader header;
+    std::memcpy(&header, entry->data(), sizeof(header));
+    if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 || header.version != cache_version
+        || header.frame_count == 0)
+        return false;
+
+    // every frame is checked against the file size, a damaged entry is dropped and decoded again
+    std::vector<uint64_t> offsets;
+    uint64_t offset = alignUp(sizeof(FileHeader));
+    for (uint64_t i = 0; i < header.frame_count; i++)
+    {
+        // the padding after the last frame may be cut off, so the offset can be past the end
+        if (offset > length || length - offset < alignUp(sizeof(FrameHeader)))
+            break;
+        FrameHeader frame_header;
+        std::memcpy(&frame_header, entry->data() + offset, sizeof(frame_header));
+        uint64_t data_offset = offset + alignUp(sizeof(FrameHeader));
+        if (length - data_offset < frame_header.data_bytes)
+            break;
+        // the frame is built from the header, it has to describe exactly the stored bytes
+        if (frame_header.rows < 0 || frame_header.cols < 0 || frame_header.type != CV_MAT_TYPE(frame_header.type)
+            || static_cast<uint64_t>(frame_header.rows) * frame_header.cols * CV_ELEM_SIZE(frame_header.type) != frame_header.data_bytes)
+            break;
+        offsets.push_back(offset);
+        offset = alignUp(data_offset + frame_header.data_bytes);
+    }
+    if (offsets.size() != header.frame_count)
+    {
+        spdlog::warn("Frame cache entry {} is damaged, removing it", entry_path);
+        std::error_code ec;
+        fs::remove(entry_path, ec);
+        return false;
+    }
+
+    mapping = std::move(entry);
+    frame_offsets = std::move(offsets);
+    fps = header.fps;
+    next_frame = 0;
+    done = false;
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.hit = true;
+    stats.frames = frame_offsets.size();
+    stats.entry_bytes = length;
+    return true;
+}
+
+void CachedVideoReader::beginWrite()
+{
+    // unique per writer, the entry appears under its final name only when complete
+    std::ostringstream name;
+    name << entry_path << "." << getpid() << "." << std::this_thread::get_id() << ".tmp";
+    write_path = name.str();
+    writer.open(write_path, std::ios::binary | std::ios::trunc);
+    if (!writer.is_open())
+    {
+        spdlog::warn("Could not write frame cache entry {}", write_path);
+        return;
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version = cache_version;
+    header.fps = fps;
+    char block[block_alignment] = {};
+    std::memcpy(block, &header, sizeof(header));
+    writer.write(block, alignUp(sizeof(FileHeader)));
+    written_bytes = alignUp(sizeof(FileHeader));
+    written_frames = 0;
+}
+
+void CachedVideoReader::writeFrame(const cv::Mat& frame)
+{
+    if (!writer.is_open())
+        return;
+    cv::Mat continuous = frame.isContinuous() ? frame : frame.clone();
+    FrameHeader header{};
+    header.rows = continuous.rows;
+    header.cols = continuous.cols;
+    header.type = continuous.type();
+    header.data_bytes = continuous.total() * continuous.elemSize();
+
+    uint64_t frame_bytes = alignUp(sizeof(FrameHeader)) + alignUp(header.data_bytes);
+    if (written_bytes + frame_bytes > args.max_bytes)
+    {
+        spdlog::info("Sequence does not fit in the frame cache of {} MB, not caching it", args.max_bytes / (1024 * 1024));
+        abandonWrite();
+        return;
+    }
+
+    char block[block_alignment] = {};
+    std::memcpy(block, &header, sizeof(header));
+    writer.write(block, alignUp(sizeof(FrameHeader)));
+    writer.write(reinterpret_cast<const char*>(continuous.data), header.data_bytes);
+    static const char padding[block_alignment] = {};
+    writer.write(padding, alignUp(header.data_bytes) - header.data_bytes);
+    written_bytes += frame_bytes;
+    written_frames++;
+    if (!writer.good())
+    {
+        spdlog::warn("Writing frame cache entry {} failed", write_path);
+        abandonWrite();
+    }
+}
+
+void CachedVideoReader::finishWrite()
+{
+    if (!writer.is_open())
+        return;
+    if (written_frames == 0)
+    {
+        abandonWrite();
+        return;
+    }
+    uint64_t frame_count = written_frames;
+    writer.seekp(offsetof(FileHeader, frame_count));
+    writer.write(reinterpret_cast<const char*>(&frame_count), sizeof(frame_count));
+    writer.close();
+
+    std::error_code ec;
+    fs::rename(write_path, entry_path, ec);
+    if (ec)
+    {
+        spdlog::warn("Could not publish frame cache entry {}: {}", entry_path, ec.message());
+        fs::remove(write_path, ec);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.stored = true;
+    stats.frames = written_frames;
+    stats.entry_bytes = written_bytes;
+    evict(args, entry_path, stats);
+}
+
+void CachedVideoReader::abandonWrite()
+{
+    if (!writer.is_open())
+        return;
+    writer.close();
+    std::error_code ec;
+    fs::remove(write_path, ec);
+}
+
+bool CachedVideoReader::getNextFrame(cv::Mat& frame)
+{
+    if (done)
+        return false;
+
+    if (mapping)
+    {
+        if (next_frame >= frame_offsets.size())
+        {
+            done = true;
+            return false;
+        }
+        uint64_t offset = frame_offsets[next_frame++];
+        FrameHeader header;
+        std::memcpy(&header, mapping->data() + offset, sizeof(header));
+        char* data = mapping->data() + offset + alignUp(sizeof(FrameHeader));
+        frame = header.rows > 0 ? cv::Mat(header.rows, header.cols, header.type, data) : cv::Mat();
+        return true;
+    }
+
+    if (!source->getNextFrame(frame))
+    {
+        done = true;
+        finishWrite();
+        return false;
+    }
+    writeFrame(frame);
+    return true;
+}
+
+bool CachedVideoReader::isDone() const
+{
+    return done;
+}
+
+void CachedVideoReader::reset()
+{
+    if (mapping)
+    {
+        next_frame = 0;
+        done = false;
+        return;
+    }
+    // a partly read sequence is not cached, it is written again from the start
+    abandonWrite();
+    source->reset();
+    done = source->isDone();
+    beginWrite();
+}
+
+double CachedVideoReader::getFps() const
+{
+    return fps;
+}
+
+FrameCacheStats CachedVideoReader::getStats()
+{
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    return stats;
+}
+
+void CachedVideoReader::evict(const FrameCacheArgs& args, const std::string& keep_path, FrameCacheStats& stats)
+{
+    struct Entry
+    {
+        fs::path path;
+        fs::file_time_type used;
+        uint64_t size;
+    };
+    std::vector<Entry> entries;
+    uint64_t total_bytes = 0;
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(args.directory, ec))
+    {
+        if (file.path().extension() != ".frames")
+            continue;
+        Entry entry{ file.path(), file.last_write_time(ec), file.file_size(ec) };
+        if (ec)
+            continue; // removed by another run meanwhile
+        total_bytes += entry.size;
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.used < b.used; });
+
+    for (const auto& entry : entries)
+    {
+        if (total_bytes <= args.max_bytes)
+            break;
+        if (entry.path == fs::path(keep_path))
+            continue;
+        // readers which already mapped the entry keep their frames
+        if (fs::remove(entry.path, ec))
+        {
+            spdlog::debug("Evicted frame cache entry {}", entry.path.string());
+            total_bytes -= entry.size;
+            stats.evicted_entries++;
+            stats.evicted_bytes += entry.size;
+        }
+    }
+}
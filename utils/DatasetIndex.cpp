@@ -0,0 +1,380 @@
+#include "DatasetIndex.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include "ImageSequenceReader.hpp"
+#include "MappedFile.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+const char index_magic[8] = { 'T', 'C', 'D', 'S', 'I', 'D', 'X', '\0' };
+const uint32_t index_version = 1;
+
+class IndexWriter
+{
+public:
+    explicit IndexWriter(std::ostream& out) : out(out) {}
+
+    template <typename T>
+    void pod(const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void string(const std::string& value)
+    {
+        pod<uint32_t>(value.size());
+        out.write(value.data(), value.size());
+    }
+
+    void stamp(const FileStamp& value)
+    {
+        pod(value.mtime);
+        pod(value.size);
+    }
+
+private:
+    std::ostream& out;
+};
+
+// Bounds checked reader of the mapped index, any inconsistency makes the whole index invalid
+class IndexReader
+{
+public:
+    explicit IndexReader(std::string_view data) : data(data) {}
+
+    template <typename T>
+    T pod()
+    {
+        T value{};
+        if (!take(sizeof(T)))
+            return value;
+        std::memcpy(&value, data.data() + pos - sizeof(T), sizeof(T));
+        return value;
+    }
+
+    std::string string()
+    {
+        uint32_t size = pod<uint32_t>();
+        if (!take(size))
+            return {};
+        return std::string(data.data() + pos - size, size);
+    }
+
+    FileStamp stamp()
+    {
+        FileStamp value;
+        value.mtime = pod<int64_t>();
+        value.size = pod<uint64_t>();
+        return value;
+    }
+
+    // Element count of a vector, checked against the bytes left so a corrupted count can not allocate
+    size_t count(size_t min_element_size)
+    {
+        uint64_t n = pod<uint64_t>();
+        if (n > (data.size() - pos) / std::max<size_t>(min_element_size, 1))
+        {
+            ok = false;
+            return 0;
+        }
+        return n;
+    }
+
+    bool good() const { return ok; }
+
+private:
+    bool take(size_t size)
+    {
+        if (!ok || data.size() - pos < size)
+        {
+            ok = false;
+            return false;
+        }
+        pos += size;
+        return true;
+    }
+
+    std::string_view data;
+    size_t pos = 0;
+    bool ok = true;
+};
+
+}
+
+FileStamp getFileStamp(const std::string& path)
+{
+    FileStamp stamp;
+    std::error_code ec;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec)
+        return stamp;
+    stamp.mtime = mtime.time_since_epoch().count();
+    if (fs::is_regular_file(path, ec))
+        stamp.size = fs::file_size(path, ec);
+    return stamp;
+}
+
+std::string DatasetIndex::getDefaultPath(const std::string& root_path)
+{
+    std::error_code ec;
+    fs::path absolute = fs::weakly_canonical(root_path, ec);
+    if (ec)
+        absolute = fs::absolute(root_path);
+    uint64_t hash = 14695981039346656037ull; // FNV-1a, stable across runs and builds
+    for (unsigned char c : absolute.string())
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.idx", static_cast<unsigned long long>(hash));
+    return (fs::path("dataset_index") / (absolute.filename().string() + "_" + name)).string();
+}
+
+DatasetIndex::DatasetIndex(const std::string& root_path, const std::string& index_path) : root_path(root_path)
+{
+    // saving creates and renames a file, which changes the modification time of its directory
+    std::error_code ec;
+    fs::path index_dir = fs::weakly_canonical(fs::absolute(index_path).parent_path(), ec);
+    fs::path root = fs::weakly_canonical(root_path, ec);
+    if (!ec && (index_dir == root || index_dir.parent_path() == root))
+        spdlog::warn("Dataset index {} is inside the dataset, the directory holding it is scanned again on every run", index_path);
+    fs::create_directories(fs::absolute(index_path).parent_path(), ec);
+    if (!load(index_path))
+        sequences.clear();
+    update();
+    if (modified && !save(index_path))
+        spdlog::warn("Could not save the dataset index to {}", index_path);
+    spdlog::info("Dataset index: {} sequences, {} scanned again", sequences.size(), rescanned_cnt);
+}
+
+std::vector<DatasetInfo> DatasetIndex::getDatasetInfos() const
+{
+    std::vector<DatasetInfo> dataset_infos;
+    for (const auto& sequence : sequences)
+    {
+        if (sequence.info.dataset_type != DatasetType::Unknown)
+            dataset_infos.push_back(sequence.info);
+    }
+    return dataset_infos;
+}
+
+void DatasetIndex::update()
+{
+    FileStamp current_root_stamp = getFileStamp(root_path);
+    // the list of sequences only has to be read again when the root directory changed
+    if (current_root_stamp != root_stamp || sequences.empty())
+    {
+        std::vector<std::string> paths;
+        for (const auto& dir : getAllDirectories(root_path))
+            paths.push_back(dir.string());
+        if (paths.empty())
+            paths.push_back(root_path); // path to a single sequence, as in loadDatasetInfos
+        std::sort(paths.begin(), paths.end());
+
+        std::vector<IndexedSequence> updated;
+        for (const auto& path : paths)
+        {
+            auto it = std::find_if(sequences.begin(), sequences.end(), [&](const IndexedSequence& s) { return s.path == path; });
+            if (it != sequences.end())
+                updated.push_back(std::move(*it));
+            else
+                updated.push_back({ path }); // scanned below
+        }
+        // removed sequences have to be saved, a root changed only by writing the index itself does not
+        if (updated.size() != sequences.size())
+            modified = true;
+        sequences = std::move(updated);
+        root_stamp = current_root_stamp;
+    }
+
+    for (auto& sequence : sequences)
+    {
+        if (!isUpToDate(sequence))
+        {
+            spdlog::debug("Scanning sequence {}", sequence.path);
+            sequence = scanSequence(sequence.path);
+            rescanned_cnt++;
+            modified = true;
+        }
+    }
+}
+
+bool DatasetIndex::isUpToDate(const IndexedSequence& sequence) const
+{
+    if (sequence.directory_stamp.mtime == 0 || getFileStamp(sequence.path) != sequence.directory_stamp)
+        return false;
+    if (sequence.info.dataset_type == DatasetType::Unknown)
+        return true;
+    if (getFileStamp(sequence.info.media_path) != sequence.media_stamp)
+        return false;
+    for (size_t i = 0; i < sequence.info.ground_truth_paths.size(); i++)
+    {
+        if (getFileStamp(sequence.info.ground_truth_paths[i]) != sequence.ground_truth_stamps[i])
+            return false;
+    }
+    return true;
+}
+
+IndexedSequence DatasetIndex::scanSequence(const std::string& path)
+{
+    IndexedSequence sequence;
+    sequence.path = path;
+    sequence.directory_stamp = getFileStamp(path);
+    sequence.info = getDatasetInfo(path);
+    DatasetInfo& info = sequence.info;
+    for (const auto& gt_path : info.ground_truth_paths)
+        sequence.ground_truth_stamps.push_back(getFileStamp(gt_path));
+    if (info.dataset_type == DatasetType::Unknown)
+        return sequence;
+    sequence.media_stamp = getFileStamp(info.media_path);
+
+    if (info.dataset_type == DatasetType::OTB)
+    {
+        info.frame_files = ImageSequenceReader::listImageFiles(info.media_path);
+        info.frame_count = info.frame_files.size();
+        if (!info.frame_files.empty())
+            info.resolution = cv::imread(info.frame_files.front()).size();
+    }
+    else
+    {
+        cv::VideoCapture video(info.media_path);
+        if (video.isOpened())
+        {
+            info.frame_count = static_cast<size_t>(std::max(0.0, video.get(cv::CAP_PROP_FRAME_COUNT)));
+            info.resolution = cv::Size(static_cast<int>(video.get(cv::CAP_PROP_FRAME_WIDTH)),
+                static_cast<int>(video.get(cv::CAP_PROP_FRAME_HEIGHT)));
+        }
+    }
+
+    if (!info.ground_truth_paths.empty())
+    {
+        try
+        {
+            info.annotations = info.dataset_type == DatasetType::OTB ? loadOTBAnnotations(info.ground_truth_paths[0])
+                : loadCustomAnnotations(info.ground_truth_paths[0]);
+        }
+        catch (const std::exception& e)
+        {
+            // left to the evaluation, which reports it for this sequence only
+            spdlog::warn("Annotations of {} not indexed: {}", path, e.what());
+        }
+    }
+    return sequence;
+}
+
+bool DatasetIndex::save(const std::string& index_path) const
+{
+    // written next to the target and renamed, a reader never sees a partial index
+    std::string tmp_path = index_path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        IndexWriter writer(out);
+        out.write(index_magic, sizeof(index_magic));
+        writer.pod(index_version);
+        writer.string(root_path);
+        writer.stamp(root_stamp);
+        writer.pod<uint64_t>(sequences.size());
+        for (const auto& sequence : sequences)
+        {
+            const DatasetInfo& info = sequence.info;
+            writer.string(sequence.path);
+            writer.stamp(sequence.directory_stamp);
+            writer.stamp(sequence.media_stamp);
+            writer.string(info.name);
+            writer.string(info.media_path);
+            writer.pod(static_cast<int32_t>(info.dataset_type));
+            writer.pod<uint64_t>(info.ground_truth_paths.size());
+            for (size_t i = 0; i < info.ground_truth_paths.size(); i++)
+            {
+                writer.string(info.ground_truth_paths[i]);
+                writer.stamp(sequence.ground_truth_stamps[i]);
+            }
+            writer.pod<uint64_t>(info.frame_files.size());
+            for (const auto& file : info.frame_files)
+                writer.string(file);
+            writer.pod<uint64_t>(info.frame_count);
+            writer.pod<int32_t>(info.resolution.width);
+            writer.pod<int32_t>(info.resolution.height);
+            writer.pod<uint64_t>(info.annotations.size());
+            for (const auto& annotation : info.annotations)
+            {
+                writer.pod(annotation.rect.x);
+                writer.pod(annotation.rect.y);
+                writer.pod(annotation.rect.width);
+                writer.pod(annotation.rect.height);
+                writer.pod<int32_t>(annotation.frame);
+                writer.pod<int32_t>(annotation.occluded);
+            }
+        }
+        if (!out.good())
+            return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp_path, index_path, ec);
+    return !ec;
+}
+
+bool DatasetIndex::load(const std::string& index_path)
+{
+    MappedFile file(index_path);
+    std::string_view data = file.view();
+    if (data.size() < sizeof(index_magic) || std::memcmp(data.data(), index_magic, sizeof(index_magic)) != 0)
+        return false;
+
+    IndexReader reader(data.substr(sizeof(index_magic)));
+    if (reader.pod<uint32_t>() != index_version || reader.string() != root_path)
+        return false;
+    root_stamp = reader.stamp();
+    sequences.resize(reader.count(1));
+    for (auto& sequence : sequences)
+    {
+        DatasetInfo& info = sequence.info;
+        sequence.path = reader.string();
+        sequence.directory_stamp = reader.stamp();
+        sequence.media_stamp = reader.stamp();
+        info.name = reader.string();
+        info.media_path = reader.string();
+        info.dataset_type = static_cast<DatasetType>(reader.pod<int32_t>());
+        size_t gt_cnt = reader.count(4 + sizeof(FileStamp));
+        for (size_t i = 0; i < gt_cnt; i++)
+        {
+            info.ground_truth_paths.push_back(reader.string());
+            sequence.ground_truth_stamps.push_back(reader.stamp());
+        }
+        info.frame_files.resize(reader.count(4));
+        for (auto& frame_file : info.frame_files)
+            frame_file = reader.string();
+        info.frame_count = reader.pod<uint64_t>();
+        info.resolution.width = reader.pod<int32_t>();
+        info.resolution.height = reader.pod<int32_t>();
+        info.annotations.resize(reader.count(6 * 4));
+        for (auto& annotation : info.annotations)
+        {
+            annotation.rect.x = reader.pod<float>();
+            annotation.rect.y = reader.pod<float>();
+            annotation.rect.width = reader.pod<float>();
+            annotation.rect.height = reader.pod<float>();
+            annotation.frame = reader.pod<int32_t>();
+            annotation.occluded = reader.pod<int32_t>();
+        }
+        if (!reader.good())
+            break;
+    }
+    if (!reader.good())
+    {
+        spdlog::warn("Dataset index {} is corrupted, rebuilding it", index_path);
+        return false;
+    }
+    return true;
+}
@@ -1,5 +1,10 @@
 #include "DatasetUtils.hpp"
+#include <algorithm>
+#include <charconv>
 #include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include "MappedFile.hpp"
 #include <spdlog/spdlog.h>
 
 namespace fs = std::filesystem;
@@ -92,6 +97,8 @@ DatasetInfo getDatasetInfo(const std::string& path)
                 dataset_info.ground_truth_paths.push_back(entry.path().string());
             }
         };
+        // directory order is arbitrary, the first annotation file is the one evaluated
+        std::sort(dataset_info.ground_truth_paths.begin(), dataset_info.ground_truth_paths.end());
     }
     else
     {
@@ -101,96 +108,198 @@ DatasetInfo getDatasetInfo(const std::string& path)
 }
 
 
+namespace
+{
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// Parses a number at p like stream extraction and std::stoi / std::stof do: leading whitespace and
+// a plus sign are accepted, parsing stops at the first character which does not belong to the number
+template <typename T>
+bool parseNumber(const char*& p, const char* end, T& value)
+{
+    while (p < end && isSpace(*p))
+        p++;
+    if (p < end && *p == '+')
+    {
+        p++;
+        if (p < end && *p == '-')
+            return false;
+    }
+    auto [ptr, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc())
+        return false;
+    p = ptr;
+    return true;
+}
+
+// Calls f for every line, like std::getline, with 1-based line numbers
+template <typename F>
+void forEachLine(std::string_view text, F f)
+{
+    size_t line_num = 1;
+    while (!text.empty())
+    {
+        size_t end = text.find('\n');
+        f(text.substr(0, end), line_num++);
+        if (end == std::string_view::npos)
+            break;
+        text.remove_prefix(end + 1);
+    }
+}
+
+size_t countLines(std::string_view text)
+{
+    return std::count(text.begin(), text.end(), '\n') + 1;
+}
+
+}
+
 std::vector<Annotation> loadOTBAnnotations(const std::string& filename)
 {
     // Each row in the ground-truth files represents the bounding box of the target in that frame,
-    // (x, y, box-width, box-height).
+    // (x, y, box-width, box-height), separated by commas or whitespace. Rows without four integers are skipped.
 
     std::vector<Annotation> annotations;
-    std::ifstream file(filename);
+    MappedFile file(filename);
 
-    if (!file.is_open())
+    if (!file.isOpen())
     {
         spdlog::error("Could not open the annotation file: {}", filename);
         return annotations;
     }
+    std::string_view text = file.view();
+    annotations.reserve(countLines(text));
     unsigned int frame_num = 0;
 
-    std::string line;
-    while (std::getline(file, line))
-    {
-        // Replace commas with spaces to handle comma-separated values
-        std::replace(line.begin(), line.end(), ',', ' ');
-
-        std::istringstream iss(line);
-        int x, y, width, height;
-        if (iss >> x >> y >> width >> height)
+    forEachLine(text, [&](std::string_view line, size_t line_num) {
+        const char* p = line.data();
+        const char* end = line.data() + line.size();
+        int values[4];
+        for (int& value : values)
         {
-            Annotation annotation;
-            annotation.rect = cv::Rect2f(x, y, width, height);
-            annotation.frame = frame_num++;
-            annotations.push_back(annotation);
+            // commas are separators, just like whitespace
+            while (p < end && (isSpace(*p) || *p == ','))
+                p++;
+            if (!parseNumber(p, end, value))
+            {
+                if (!line.empty())
+                    spdlog::debug("{}:{}: no bounding box, line skipped", filename, line_num);
+                return;
+            }
         }
-    }
+        Annotation annotation;
+        annotation.rect = cv::Rect2f(values[0], values[1], values[2], values[3]);
+        annotation.frame = frame_num++;
+        annotations.push_back(annotation);
+        });
 
-    file.close();
     return annotations;
 }
 
 std::vector<Annotation> loadCustomAnnotations(const std::string& filename)
 {
+    // Each row is "frame" for frames without the target or "frame,x,y,width,height,occluded" with
+    // the box center and size normalized to the frame size. Throws std::invalid_argument on malformed rows.
+
     std::vector<Annotation> annotations;
-    std::ifstream file(filename);
+    MappedFile file(filename);
 
-    if (!file.is_open())
+    if (!file.isOpen())
     {
         spdlog::error("Could not open the annotation file: {}", filename);
         return annotations;
     }
+    std::string_view text = file.view();
+    annotations.reserve(countLines(text));
 
-    std::string line;
-    while (std::getline(file, line))
-    {
-        std::istringstream ss(line);
-        std::string token;
+    forEachLine(text, [&](std::string_view line, size_t line_num) {
+        auto fail = [&](const std::string& reason) {
+            throw std::invalid_argument(filename + ":" + std::to_string(line_num) + ": " + reason);
+        };
+        // fields are parsed in place, each ends at the next comma
+        std::string_view fields[6];
+        size_t fields_num = 0;
+        std::string_view rest = line;
+        while (fields_num < 6)
+        {
+            size_t comma = rest.find(',');
+            fields[fields_num++] = rest.substr(0, comma);
+            if (comma == std::string_view::npos)
+                break;
+            rest.remove_prefix(comma + 1);
+            if (rest.empty())
+                break; // a trailing comma does not start another field
+        }
+        auto parseField = [&](size_t index, auto& value, const char* name) {
+            const char* p = fields[index].data();
+            if (!parseNumber(p, fields[index].data() + fields[index].size(), value))
+                fail(std::string("invalid ") + name + " value");
+        };
 
-        // Parse frame number
-        std::getline(ss, token, ',');
-        int frame = std::stoi(token);
+        Annotation annotation;
+        parseField(0, annotation.frame, "frame");
 
         // Check if the line contains annotation data
-        if (std::getline(ss, token, ','))
+        if (fields_num > 1)
         {
-            // Parse the rest of the annotation data
-            float norm_x = std::stof(token);
-            std::getline(ss, token, ',');
-            float norm_y = std::stof(token);
-            std::getline(ss, token, ',');
-            float norm_width = std::stof(token);
-            std::getline(ss, token, ',');
-            float norm_height = std::stof(token);
-            std::getline(ss, token, ',');
-            int occluded = std::stoi(token);
+            if (fields_num < 6)
+                fail("expected 6 comma separated values, got " + std::to_string(fields_num));
+            float norm_x, norm_y, norm_width, norm_height;
+            parseField(1, norm_x, "x");
+            parseField(2, norm_y, "y");
+            parseField(3, norm_width, "width");
+            parseField(4, norm_height, "height");
+            parseField(5, annotation.occluded, "occluded");
 
             // Create the floating-point rectangle (cv::Rect2f)
-            cv::Rect2f rect(norm_x - norm_width / 2, norm_y - norm_height / 2, norm_width, norm_height);
+            annotation.rect = cv::Rect2f(norm_x - norm_width / 2, norm_y - norm_height / 2, norm_width, norm_height);
+        }
+        annotations.push_back(annotation);
+        });
+
+    return annotations;
+}
 
-            Annotation annotation;
-            annotation.rect = rect;
-            annotation.frame = frame;
-            annotation.occluded = occluded;
+size_t estimateSequenceLength(const DatasetInfo& dataset_info)
+{
+    // Cheap length estimate used for scheduling, without decoding any frame
+    if (dataset_info.frame_count > 0)
+        return dataset_info.frame_count;
 
-            annotations.push_back(annotation);
+    if (dataset_info.dataset_type == DatasetType::OTB && fs::is_directory(dataset_info.media_path))
+    {
+        size_t images_num = 0;
+        for (const auto& entry : fs::directory_iterator(dataset_info.media_path))
+        {
+            if (entry.is_regular_file())
+                images_num++;
         }
-        else
+        return images_num;
+    }
+
+    if (!dataset_info.ground_truth_paths.empty())
+    {
+        std::ifstream file(dataset_info.ground_truth_paths[0]);
+        size_t lines_num = 0;
+        std::string line;
+        while (std::getline(file, line))
         {
-            // Only frame number, no annotations
-            Annotation annotation;
-            annotation.frame = frame;
-            annotations.push_back(annotation);
+            if (!line.empty())
+                lines_num++;
         }
+        if (lines_num > 0)
+            return lines_num;
     }
 
-    file.close();
-    return annotations;
-}
\ No newline at end of file
+    if (!dataset_info.media_path.empty() && fs::is_regular_file(dataset_info.media_path))
+    {
+        cv::VideoCapture video(dataset_info.media_path);
+        if (video.isOpened())
+            return static_cast<size_t>(std::max(0.0, video.get(cv::CAP_PROP_FRAME_COUNT)));
+    }
+    return 0;
+}
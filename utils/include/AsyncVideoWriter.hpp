@@ -0,0 +1,62 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <opencv2/opencv.hpp>
+
+// What to do with a frame written while the encoder queue is full
+enum class QueueFullPolicy
+{
+    Block,
+    Drop
+};
+
+QueueFullPolicy parseQueueFullPolicy(const std::string& policy);
+
+struct AsyncVideoWriterArgs
+{
+    std::string path;
+    std::string codec = "mp4v";
+    double fps = 25;
+    cv::Size frame_size; // empty size means the size of the first written frame
+    size_t queue_size = 16;
+    QueueFullPolicy full_policy = QueueFullPolicy::Block;
+};
+
+struct VideoWriterStats
+{
+    size_t frames_written = 0;
+    size_t frames_dropped = 0; // rejected because the queue was full
+    size_t frames_resized = 0; // did not match the output size
+};
+
+// Encodes frames on a dedicated thread fed by a bounded queue
+class AsyncVideoWriter
+{
+public:
+    AsyncVideoWriter(const AsyncVideoWriterArgs& args);
+    ~AsyncVideoWriter();
+
+    // The frame data must not be modified after it is passed here, returns false when the frame was dropped
+    bool write(const cv::Mat& frame);
+    // Encodes everything queued and closes the file
+    void finish();
+    VideoWriterStats getStats();
+
+private:
+    void writerLoop();
+    void encode(const cv::Mat& frame);
+
+    AsyncVideoWriterArgs args;
+    cv::VideoWriter writer;
+    bool open_failed = false;
+    std::deque<cv::Mat> queue;
+    std::mutex mutex;
+    std::condition_variable frame_ready;
+    std::condition_variable slot_free;
+    bool finishing = false;
+    VideoWriterStats stats;
+    std::thread writer_thread;
+};
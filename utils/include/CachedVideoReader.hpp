@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "VideoReader.hpp"
+
+class MappedFile;
+
+struct FrameCacheArgs
+{
+    std::string directory = "frame_cache";
+    uint64_t max_bytes = 8ull * 1024 * 1024 * 1024; // least recently used entries are evicted above it
+};
+
+struct FrameCacheStats
+{
+    bool hit = false;          // frames served from the cache, nothing decoded
+    bool stored = false;       // the sequence was decoded and added to the cache
+    size_t frames = 0;
+    uint64_t entry_bytes = 0;
+    size_t evicted_entries = 0;
+    uint64_t evicted_bytes = 0;
+};
+
+// Serves decoded frames of a media path from an on-disk cache of raw frames, keyed by the path and its
+// modification time. On a miss the frames come from the source reader and are written to the cache while they
+// are read, the entry is published once the whole sequence was read. Cached frames are memory mapped and handed
+// out without a copy, they stay valid as long as the reader, writes to them never reach the cache file.
+class CachedVideoReader : public VideoReader
+{
+public:
+    using SourceFactory = std::function<std::unique_ptr<VideoReader>()>;
+
+    // The source is only created on a cache miss
+    CachedVideoReader(const std::string& media_path, SourceFactory source_factory, const FrameCacheArgs& args);
+    ~CachedVideoReader();
+
+    bool getNextFrame(cv::Mat& frame) override;
+    bool isDone() const override;
+    void reset() override;
+    double getFps() const override;
+
+    FrameCacheStats getStats();
+
+    // Name of the cache entry of a media path in its current version
+    static std::string entryName(const std::string& media_path);
+    // Removes least recently used entries until the cache fits in max_bytes, keep_path is never removed
+    static void evict(const FrameCacheArgs& args, const std::string& keep_path, FrameCacheStats& stats);
+
+private:
+    bool openEntry();
+    void beginWrite();
+    void writeFrame(const cv::Mat& frame);
+    void finishWrite();
+    void abandonWrite();
+
+    std::string entry_path;
+    SourceFactory source_factory;
+    FrameCacheArgs args;
+
+    std::shared_ptr<MappedFile> mapping; // copy-on-write
+    std::vector<uint64_t> frame_offsets; // frame headers in the mapping
+    size_t next_frame = 0;
+
+    std::unique_ptr<VideoReader> source;
+    std::ofstream writer;
+    std::string write_path;
+    uint64_t written_bytes = 0;
+    size_t written_frames = 0;
+
+    double fps = 0;
+    bool done = false;
+    std::mutex stats_mutex;
+    FrameCacheStats stats;
+};
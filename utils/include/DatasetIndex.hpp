@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DatasetUtils.hpp"
+
+// Size and modification time of a file or directory, a directory changes when entries are added or removed
+struct FileStamp
+{
+    int64_t mtime = 0;
+    uint64_t size = 0;
+
+    bool operator==(const FileStamp& other) const { return mtime == other.mtime && size == other.size; }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+FileStamp getFileStamp(const std::string& path);
+
+struct IndexedSequence
+{
+    std::string path; // sequence directory
+    FileStamp directory_stamp;
+    FileStamp media_stamp;
+    std::vector<FileStamp> ground_truth_stamps;
+    DatasetInfo info; // Unknown type for directories which are not sequences
+};
+
+// On-disk index of the sequences under a dataset root, with sorted frame lists, frame counts, resolutions and
+// parsed annotations. Revalidated on load with a few stats per sequence, only sequences whose files changed are
+// scanned again.
+class DatasetIndex
+{
+public:
+    // Loads the index from index_path and brings it up to date with root_path, saves it back if anything changed
+    DatasetIndex(const std::string& root_path, const std::string& index_path);
+    // dataset_index/<root name>_<hash of its absolute path>.idx in the working directory, outside the dataset,
+    // so writing the index does not change the directories whose modification times it checks
+    static std::string getDefaultPath(const std::string& root_path);
+
+    // Same sequences as loadDatasetInfos(root_path) returns, with the indexed data filled in
+    std::vector<DatasetInfo> getDatasetInfos() const;
+    size_t getRescannedCount() const { return rescanned_cnt; }
+
+    bool save(const std::string& index_path) const;
+    bool load(const std::string& index_path);
+
+private:
+    void update();
+    bool isUpToDate(const IndexedSequence& sequence) const;
+    static IndexedSequence scanSequence(const std::string& path);
+
+    std::string root_path;
+    FileStamp root_stamp;
+    std::vector<IndexedSequence> sequences;
+    size_t rescanned_cnt = 0;
+    bool modified = false; // differs from the loaded index
+};
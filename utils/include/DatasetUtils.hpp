@@ -12,19 +12,25 @@ enum class DatasetType
     Unknown
 };
 
+struct Annotation
+{
+    cv::Rect2f rect;   
+    int frame;         
+    int occluded = -1; // Occlusion status, default is -1 indicating unknown
+};
+
 struct DatasetInfo
 {
     std::string name;
     std::string media_path;
     DatasetType dataset_type = DatasetType::Unknown;
     std::vector<std::string> ground_truth_paths;
-};
 
-struct Annotation
-{
-    cv::Rect2f rect;   
-    int frame;         
-    int occluded = -1; // Occlusion status, default is -1 indicating unknown
+    // only filled when loaded from a DatasetIndex, empty means unknown
+    std::vector<std::string> frame_files; // sorted images of an OTB sequence
+    size_t frame_count = 0;
+    cv::Size resolution;
+    std::vector<Annotation> annotations;  // parsed ground_truth_paths[0], custom ones still normalized
 };
 
 std::ostream &operator<<(std::ostream &os, const DatasetInfo &datasetInfo);
@@ -33,5 +39,6 @@ std::vector<DatasetInfo> loadDatasetInfos(const std::string & path);
 DatasetInfo getDatasetInfo(const std::string &path);
 std::vector<Annotation> loadOTBAnnotations(const std::string& filename);
 std::vector<Annotation> loadCustomAnnotations(const std::string& filename);
+size_t estimateSequenceLength(const DatasetInfo& dataset_info);
 
 
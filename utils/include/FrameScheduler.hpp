@@ -0,0 +1,149 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct FrameSchedulerStats
+{
+    size_t pushed = 0;
+    size_t dispatched = 0;
+    size_t dropped_full = 0;  // oldest frame pushed out by a new one arriving to a full queue
+    size_t dropped_stale = 0; // waited longer than max_age for a worker
+};
+
+// Hands frames of many live streams to a shared set of workers.
+// Every stream queues at most queue_depth frames and has at most one frame in flight, so stateful per stream
+// work (eg. a tracker) sees its frames in order. Streams are served round robin. Frames which waited longer than
+// max_age are dropped at dispatch, unless they are the newest of their stream.
+template <typename Frame>
+class FrameScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        size_t stream;
+        Frame frame;
+        Clock::time_point arrival;
+    };
+
+    // max_age of zero keeps frames until they are dispatched or pushed out
+    FrameScheduler(size_t streams_num, size_t queue_depth, Clock::duration max_age = Clock::duration::zero())
+        : streams(streams_num), queue_depth(queue_depth > 0 ? queue_depth : 1), max_age(max_age)
+    {
+    }
+
+    void push(size_t stream, Frame frame, Clock::time_point arrival = Clock::now())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Stream& s = streams[stream];
+            if (s.queue.size() == queue_depth)
+            {
+                s.queue.pop_front();
+                s.stats.dropped_full++;
+            }
+            s.queue.push_back(Job{ stream, std::move(frame), arrival });
+            s.stats.pushed++;
+        }
+        job_ready.notify_one();
+    }
+
+    // No more frames will be pushed to the stream, the queued ones are still dispatched
+    void finishStream(size_t stream)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            streams[stream].finished = true;
+        }
+        job_ready.notify_all();
+    }
+
+    // Blocks until a frame of an idle stream is queued, false once every stream is finished and drained or stop was called
+    bool acquire(Job& job)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            if (stopping)
+                return false;
+            bool pending = false;
+            for (size_t i = 0; i < streams.size(); i++)
+            {
+                size_t index = (next_stream + i) % streams.size();
+                Stream& s = streams[index];
+                pending = pending || !s.queue.empty() || s.busy || !s.finished;
+                if (s.busy || s.queue.empty())
+                    continue;
+
+                dropStale(s, Clock::now());
+                job = std::move(s.queue.front());
+                s.queue.pop_front();
+                s.busy = true;
+                s.stats.dispatched++;
+                next_stream = (index + 1) % streams.size();
+                return true;
+            }
+            if (!pending)
+                return false;
+            job_ready.wait(lock);
+        }
+    }
+
+    // The worker is done with the last frame of the stream
+    void release(size_t stream)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            streams[stream].busy = false;
+        }
+        job_ready.notify_all();
+    }
+
+    // Wakes up every worker, acquire returns false from now on
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        job_ready.notify_all();
+    }
+
+    FrameSchedulerStats getStats(size_t stream)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return streams[stream].stats;
+    }
+
+private:
+    struct Stream
+    {
+        std::deque<Job> queue;
+        bool busy = false;
+        bool finished = false;
+        FrameSchedulerStats stats;
+    };
+
+    void dropStale(Stream& s, Clock::time_point now)
+    {
+        if (max_age == Clock::duration::zero())
+            return;
+        while (s.queue.size() > 1 && now - s.queue.front().arrival > max_age)
+        {
+            s.queue.pop_front();
+            s.stats.dropped_stale++;
+        }
+    }
+
+    std::vector<Stream> streams;
+    size_t queue_depth;
+    Clock::duration max_age;
+    size_t next_stream = 0;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable job_ready;
+};
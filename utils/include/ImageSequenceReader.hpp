@@ -1,10 +1,21 @@
 #pragma once
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <future>
 #include "VideoReader.hpp"
+#include "ThreadPool.hpp"
 
 namespace fs = std::filesystem;
 
+struct ImageSequenceReaderArgs
+{
+    size_t lookahead = 0;                          // images decoded ahead in parallel, 0 decodes on demand
+    size_t decode_threads = 4;
+    size_t memory_budget_bytes = 512 * 1024 * 1024; // cap for decoded images waiting in the lookahead window
+};
+
 class ImageSequenceReader : public VideoReader
 {
 private:
@@ -12,9 +23,72 @@ private:
     size_t currentIndex;
     bool done;
 
+    ImageSequenceReaderArgs args;
+    // bumped to cancel the queued decodes, declared before the pool so it outlives the tasks
+    std::atomic<unsigned> decodeGeneration{ 0 };
+    std::unique_ptr<ThreadPool> decodePool;
+    std::deque<std::future<cv::Mat>> pending; // decodes of images [currentIndex, nextToSchedule)
+    size_t nextToSchedule = 0;
+    size_t frameBytes = 0; // size of the last decoded image, estimates the memory of the window
+
+    // Queued decodes are dropped, the running ones are waited for so they do not compete with the next window
+    void cancelDecodes()
+    {
+        decodeGeneration++;
+        for (auto& decode : pending)
+            decode.wait();
+        pending.clear();
+    }
+
+    void scheduleDecodes()
+    {
+        // until the first image is decoded its size is unknown, so only one is requested
+        size_t window = 1;
+        if (frameBytes > 0)
+            window = std::max<size_t>(1, std::min(args.lookahead, args.memory_budget_bytes / frameBytes));
+
+        while (pending.size() < window && nextToSchedule < imageFiles.size())
+        {
+            std::string path = imageFiles[nextToSchedule++];
+            unsigned generation = decodeGeneration;
+            pending.push_back(decodePool->submit([this, path, generation]() {
+                // cancelled decodes which have not started yet are skipped
+                if (generation != decodeGeneration)
+                    return cv::Mat();
+                return cv::imread(path);
+            }));
+        }
+    }
+
 public:
-    ImageSequenceReader(const std::string &directoryPath) : currentIndex(0), done(false)
+    ImageSequenceReader(const std::string &directoryPath, const ImageSequenceReaderArgs &readerArgs = ImageSequenceReaderArgs())
+        : ImageSequenceReader(listImageFiles(directoryPath), readerArgs)
+    {
+        if (imageFiles.empty())
+            std::cerr << "No images found in directory: " << directoryPath << std::endl;
+    }
+
+    // Reads an already listed and sorted sequence, eg. from a DatasetIndex, without touching the directory
+    ImageSequenceReader(std::vector<std::string> sortedImageFiles, const ImageSequenceReaderArgs &readerArgs = ImageSequenceReaderArgs())
+        : imageFiles(std::move(sortedImageFiles)), currentIndex(0), done(false), args(readerArgs)
     {
+        if (imageFiles.empty())
+            done = true;
+
+        if (args.lookahead > 0)
+            decodePool = std::make_unique<ThreadPool>(args.decode_threads);
+    }
+
+    ~ImageSequenceReader()
+    {
+        // the pool runs every queued task before it stops, the cancelled ones return at once
+        decodeGeneration++;
+    }
+
+    // Images of the sequence in reading order
+    static std::vector<std::string> listImageFiles(const std::string &directoryPath)
+    {
+        std::vector<std::string> files;
         for (const auto &entry : fs::directory_iterator(directoryPath))
         {
             if (entry.is_regular_file())
@@ -22,18 +96,13 @@ public:
                 std::string ext = entry.path().extension().string();
                 if (ext == ".jpg" || ext == ".jpeg" || ext == ".png")
                 {
-                    imageFiles.push_back(entry.path().string());
+                    files.push_back(entry.path().string());
                 }
             }
         }
 
-        std::sort(imageFiles.begin(), imageFiles.end());
-
-        if (imageFiles.empty())
-        {
-            std::cerr << "No images found in directory: " << directoryPath << std::endl;
-            done = true;
-        }
+        std::sort(files.begin(), files.end());
+        return files;
     }
 
     bool getNextFrame(cv::Mat &frame) override
@@ -44,7 +113,17 @@ public:
             return false;
         }
 
-        frame = cv::imread(imageFiles[currentIndex]);
+        if (decodePool)
+        {
+            scheduleDecodes();
+            frame = pending.front().get();
+            pending.pop_front();
+        }
+        else
+        {
+            frame = cv::imread(imageFiles[currentIndex]);
+        }
+
         if (frame.empty())
         {
             std::cerr << "Failed to load image: " << imageFiles[currentIndex] << std::endl;
@@ -52,7 +131,10 @@ public:
             return false;
         }
 
+        frameBytes = frame.total() * frame.elemSize();
         currentIndex++;
+        if (decodePool)
+            scheduleDecodes();
         return true;
     }
 
@@ -61,8 +143,16 @@ public:
         return done;
     }
 
+    // Decodes scheduled ahead of the next frame, bounded by the lookahead and the memory budget
+    size_t getPendingDecodes() const
+    {
+        return pending.size();
+    }
+
     void reset() override
     {
+        cancelDecodes();
+        nextToSchedule = 0;
         currentIndex = 0;
         done = false;
     }
@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of a whole file, empty files map to an empty view.
+// A copy-on-write mapping is writable, the written pages become private copies and never reach the file.
+class MappedFile
+{
+private:
+    void* address = nullptr;
+    size_t length = 0;
+    bool opened = false;
+
+public:
+    explicit MappedFile(const std::string& path, bool copy_on_write = false)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (fstat(fd, &st) == 0)
+        {
+            length = static_cast<size_t>(st.st_size);
+            opened = true;
+            if (length > 0)
+            {
+                address = mmap(nullptr, length, copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address == MAP_FAILED)
+                {
+                    address = nullptr;
+                    opened = false;
+                }
+                else
+                {
+                    madvise(address, length, MADV_SEQUENTIAL);
+                }
+            }
+        }
+        close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (address)
+            munmap(address, length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const
+    {
+        return opened;
+    }
+
+    // Writable only in a copy-on-write mapping
+    char* data() const
+    {
+        return static_cast<char*>(address);
+    }
+
+    std::string_view view() const
+    {
+        return address ? std::string_view(static_cast<const char*>(address), length) : std::string_view();
+    }
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "VideoReader.hpp"
+
+struct PrefetchStats
+{
+    size_t frames_delivered = 0;
+    size_t consumer_stalls = 0;      // getNextFrame calls which had to wait for the decoder
+    double consumer_stall_time = 0;  // total time spent waiting, in seconds
+    size_t producer_waits = 0;       // decoder blocked because the ring was full
+};
+
+// Decorator decoding frames of any VideoReader ahead of time on a background thread.
+// Frames are kept in a bounded ring of reusable buffers, the decoder blocks when the ring is full.
+class PrefetchingVideoReader : public VideoReader
+{
+private:
+    std::unique_ptr<VideoReader> source;
+    std::vector<cv::Mat> ring;
+    size_t head = 0;   // next slot handed to the consumer
+    size_t ready = 0;  // decoded frames waiting in the ring
+    bool source_finished = false;
+    bool stop_requested = false;
+    bool done = false;
+    PrefetchStats stats;
+    double fps = 0; // read once, the source is owned by the decoder thread afterwards
+
+    std::thread decoder;
+    mutable std::mutex mutex;
+    std::condition_variable frame_ready;
+    std::condition_variable slot_free;
+
+    void decodeLoop()
+    {
+        while (true)
+        {
+            size_t slot;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (ready == ring.size())
+                    stats.producer_waits++;
+                slot_free.wait(lock, [this] { return stop_requested || ready < ring.size(); });
+                if (stop_requested)
+                    return;
+                slot = (head + ready) % ring.size();
+            }
+
+            // the slot is owned by the decoder until it is published
+            bool ok = source->getNextFrame(ring[slot]);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (ok)
+                    ready++;
+                else
+                    source_finished = true;
+            }
+            frame_ready.notify_one();
+            if (!ok)
+                return;
+        }
+    }
+
+    void startDecoder()
+    {
+        head = 0;
+        ready = 0;
+        source_finished = false;
+        stop_requested = false;
+        done = source->isDone();
+        decoder = std::thread(&PrefetchingVideoReader::decodeLoop, this);
+    }
+
+    void stopDecoder()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop_requested = true;
+        }
+        slot_free.notify_all();
+        if (decoder.joinable())
+            decoder.join();
+    }
+
+public:
+    PrefetchingVideoReader(std::unique_ptr<VideoReader> source_reader, size_t depth)
+        : source(std::move(source_reader)), ring(std::max<size_t>(depth, 1))
+    {
+        fps = source->getFps();
+        startDecoder();
+    }
+
+    ~PrefetchingVideoReader()
+    {
+        stopDecoder();
+    }
+
+    bool getNextFrame(cv::Mat& frame) override
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (done)
+            return false;
+        if (ready == 0 && !source_finished)
+        {
+            stats.consumer_stalls++;
+            auto wait_start = std::chrono::steady_clock::now();
+            frame_ready.wait(lock, [this] { return ready > 0 || source_finished; });
+            std::chrono::duration<double> waited = std::chrono::steady_clock::now() - wait_start;
+            stats.consumer_stall_time += waited.count();
+        }
+        if (ready == 0)
+        {
+            done = true;
+            return false;
+        }
+
+        std::swap(frame, ring[head]);
+        // the buffer given back by the consumer is decoded into later, unless someone still shares it
+        if (ring[head].u && ring[head].u->refcount > 1)
+            ring[head].release();
+        head = (head + 1) % ring.size();
+        ready--;
+        stats.frames_delivered++;
+        lock.unlock();
+        slot_free.notify_one();
+        return true;
+    }
+
+    // True once every frame of the source was handed out, like the wrapped readers and without a failing getNextFrame
+    bool isDone() const override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return done || (source_finished && ready == 0);
+    }
+
+    void reset() override
+    {
+        stopDecoder();
+        source->reset();
+        startDecoder();
+    }
+
+    double getFps() const override
+    {
+        return fps;
+    }
+
+    PrefetchStats getStats()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+};
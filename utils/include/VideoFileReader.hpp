@@ -6,6 +6,7 @@ class VideoFileReader : public VideoReader
 private:
     cv::VideoCapture video;
     bool done;
+    double fps = 0;
 
 public:
     VideoFileReader(const std::string &videoPath) : done(false)
@@ -16,6 +17,10 @@ public:
             std::cerr << "Failed to open video file: " << videoPath << std::endl;
             done = true;
         }
+        else
+        {
+            fps = video.get(cv::CAP_PROP_FPS);
+        }
     }
 
     bool getNextFrame(cv::Mat &frame) override
@@ -41,4 +46,9 @@ public:
         video.set(cv::CAP_PROP_POS_FRAMES, 0);
         done = false;
     }
+
+    double getFps() const override
+    {
+        return fps;
+    }
 };
@@ -12,4 +12,10 @@ public:
     virtual bool isDone() const = 0;
 
     virtual void reset() = 0;
+
+    // Native frame rate of the source, 0 when it is unknown
+    virtual double getFps() const
+    {
+        return 0;
+    }
 };